@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2026 LingmoOS Team
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "incubationhelper.h"
+
+#include <QQmlEngine>
+#include <QQmlIncubationController>
+
+IncubationHelper::IncubationHelper(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool IncubationHelper::hasController() const
+{
+    return qmlEngine(this)->incubationController();
+}
+
+void IncubationHelper::removeController()
+{
+    qmlEngine(this)->setIncubationController(nullptr);
+}
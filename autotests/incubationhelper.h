@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2026 LingmoOS Team
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <QObject>
+#include <qqmlregistration.h>
+
+/**
+ * Lets tests run without the incubation controller QQuickView installs,
+ * the way an application using QQmlApplicationEngine does.
+ */
+class IncubationHelper : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+public:
+    explicit IncubationHelper(QObject *parent = nullptr);
+
+    Q_INVOKABLE bool hasController() const;
+    Q_INVOKABLE void removeController();
+};
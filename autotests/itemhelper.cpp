@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2026 LingmoOS Team
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "itemhelper.h"
+
+#include <QtQuick/private/qquickitem_p.h>
+
+ItemHelper::ItemHelper(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool ItemHelper::isCulled(QQuickItem *item) const
+{
+    return item && QQuickItemPrivate::get(item)->culled;
+}
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2026 LingmoOS Team
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <QObject>
+#include <QQuickItem>
+#include <qqmlregistration.h>
+
+/**
+ * Exposes item state QML doesn't see, like whether an item is culled
+ * from rendering while staying visible.
+ */
+class ItemHelper : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+public:
+    explicit ItemHelper(QObject *parent = nullptr);
+
+    Q_INVOKABLE bool isCulled(QQuickItem *item) const;
+};
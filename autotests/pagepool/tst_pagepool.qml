@@ -9,6 +9,7 @@ import QtQuick.Controls
 import QtQuick.Window
 import org.kde.lingmoui as LingmoUI
 import QtTest
+import LingmoUITestUtils
 
 TestCase {
     id: testCase
@@ -176,4 +177,145 @@ TestCase {
         }
         compare(pool.urls.length, 0, "all urls have been deleted")
     }
+
+    LingmoUI.PagePool {
+        id: boundedPool
+    }
+
+    SignalSpy {
+        id: evictedSpy
+        target: boundedPool
+        signalName: "pageEvicted"
+    }
+
+    function test_eviction() {
+        boundedPool.clear()
+        boundedPool.maximumPages = 2
+        evictedSpy.clear()
+
+        const first = boundedPool.loadPage("TestPage.qml?eviction=1")
+        boundedPool.loadPage("TestPage.qml?eviction=2")
+        // Loading the first page again makes the second one the least recently used
+        compare(boundedPool.loadPage("TestPage.qml?eviction=1"), first)
+        boundedPool.loadPage("TestPage.qml?eviction=3")
+
+        compare(evictedSpy.count, 1)
+        verify(evictedSpy.signalArguments[0][0].toString().endsWith("eviction=2"))
+        verify(boundedPool.contains("TestPage.qml?eviction=1"))
+        verify(!boundedPool.contains("TestPage.qml?eviction=2"))
+        verify(boundedPool.contains("TestPage.qml?eviction=3"))
+        verify(boundedPool.totalCost > 0)
+
+        // Pages shown in a PageRow are kept
+        mainWindow.pageStack.push(first)
+        boundedPool.maximumPages = 1
+        verify(boundedPool.contains("TestPage.qml?eviction=1"))
+        compare(boundedPool.urls.length, 2)
+
+        boundedPool.maximumPages = 0
+        boundedPool.clear()
+        compare(boundedPool.totalCost, 0)
+    }
+
+    SignalSpy {
+        id: readySpy
+        target: pool
+        signalName: "pageReady"
+    }
+
+    function test_loadPageAsync() {
+        readySpy.clear()
+        const url = "TestPage.qml?action=loadPageAsync"
+        pool.loadPageAsync(url, { title: "ASYNC TITLE" })
+        verify(pool.loading)
+        verify(!pool.contains(url))
+
+        tryCompare(pool, "loading", false)
+        compare(readySpy.count, 1)
+        verify(pool.contains(url))
+        compare(pool.lastLoadedItem.title, "ASYNC TITLE")
+
+        // Cached pages are ready straight away
+        let loaded = null
+        pool.loadPageAsync(url, {}, item => loaded = item)
+        compare(loaded, pool.lastLoadedItem)
+        compare(readySpy.count, 2)
+    }
+
+    function test_loadPageAsyncWithoutController() {
+        // Like with QQmlApplicationEngine, which leaves the controller to the windows
+        IncubationHelper.removeController()
+        verify(!IncubationHelper.hasController())
+
+        readySpy.clear()
+        const url = "TestPage.qml?action=loadPageAsyncWithoutController"
+        pool.loadPageAsync(url)
+        verify(pool.loading)
+        compare(readySpy.count, 0)
+
+        // The pool hands the page over to the controller of its window instead of blocking
+        tryVerify(() => IncubationHelper.hasController())
+        tryCompare(pool, "loading", false)
+        compare(readySpy.count, 1)
+        verify(pool.contains(url))
+    }
+
+    function test_preload() {
+        const url = "TestPage.qml?action=preload"
+        const lastLoadedUrl = pool.lastLoadedUrl
+        pool.preload(url, 0, true)
+        verify(!pool.contains(url))
+
+        tryVerify(() => pool.contains(url))
+        compare(pool.lastLoadedUrl, lastLoadedUrl)
+
+        const item = pool.pageForUrl(url)
+        compare(pool.loadPage(url), item)
+        verify(pool.lastLoadedUrl.toString().endsWith(url))
+
+        // Preloading a cached page does nothing
+        pool.preload(url, 0, true)
+        pool.cancelPreload(url)
+        compare(pool.pageForUrl(url), item)
+    }
+
+    function test_preloadWithoutController() {
+        IncubationHelper.removeController()
+        const url = "TestPage.qml?action=preloadWithoutController"
+        pool.preload(url, 0, true)
+        verify(!pool.contains(url))
+
+        // Created in slices by the controller of the pool's window
+        tryVerify(() => pool.contains(url))
+        verify(IncubationHelper.hasController())
+    }
+
+    function test_componentCache() {
+        const url = "TestPage.qml?action=componentCache"
+        const otherUrl = "TestPage.qml?action=componentCacheOther"
+        compare(pool.componentCount, 0)
+        compare(pool.maximumComponents, 16)
+
+        // Components outlive the pages created from them
+        pool.loadPage(url)
+        compare(pool.componentCount, 1)
+        pool.deletePage(url)
+        verify(!pool.contains(url))
+        compare(pool.componentCount, 1)
+        verify(pool.loadPage(url))
+        compare(pool.componentCount, 1)
+
+        pool.maximumComponents = 1
+        pool.loadPage(otherUrl)
+        compare(pool.componentCount, 1)
+
+        pool.cacheComponents = false
+        compare(pool.componentCount, 0)
+        pool.deletePage(url)
+        verify(pool.loadPage(url))
+        compare(pool.componentCount, 0)
+
+        pool.cacheComponents = true
+        pool.maximumComponents = 16
+    }
 }
@@ -284,4 +284,202 @@ TestCase {
         compare(t.height, 100)
         compare(s.height, 100)
     }
+
+    // Delegate items are only created for the way each action can be displayed
+    function test_lazy_delegates() {
+        var toolbar = createTemporaryObject(mixed, testCase, {width: testCase.width})
+
+        verify(toolbar)
+        verify(waitForRendering(toolbar))
+
+        while (toolbar.visibleWidth == 0) {
+            // Same as above
+            wait(50)
+        }
+
+        // One item each for the IconOnly, the normal and the displayComponent
+        // actions, none for the AlwaysHide one, two for the KeepVisible one
+        // and the more button.
+        compare(toolbar.contentItem.children.length, 6)
+    }
+
+    // Resizing only changes which actions fit, back and forth
+    function test_resize() {
+        var toolbar = createTemporaryObject(multiple, testCase, {width: testCase.width})
+
+        verify(toolbar)
+        verify(waitForRendering(toolbar))
+
+        while (toolbar.visibleWidth == 0) {
+            // Same as above
+            wait(50)
+        }
+
+        const fullWidth = testCase.textIconButton.width * 3 + LingmoUI.Units.smallSpacing * 2
+        compare(toolbar.visibleWidth, fullWidth)
+        compare(toolbar.contentItem.hiddenActions.length, 0)
+
+        toolbar.width = testCase.textIconButton.width * 2 + testCase.iconButton.width + LingmoUI.Units.smallSpacing * 3
+        tryCompare(toolbar, "visibleWidth", testCase.textIconButton.width * 2 + testCase.iconButton.width + LingmoUI.Units.smallSpacing * 2)
+        compare(toolbar.contentItem.hiddenActions.length, 1)
+
+        toolbar.width = 50
+        tryCompare(toolbar, "visibleWidth", testCase.iconButton.width)
+        compare(toolbar.contentItem.hiddenActions.length, 3)
+
+        toolbar.width = testCase.width
+        tryCompare(toolbar, "visibleWidth", fullWidth)
+        compare(toolbar.contentItem.hiddenActions.length, 0)
+    }
+
+    Component {
+        id: otherAction
+        LingmoUI.Action { icon.name: "document-open"; text: "Other Action" }
+    }
+
+    // Replacing the actions reuses the items of the removed ones
+    function test_recycling() {
+        var toolbar = createTemporaryObject(multiple, testCase, {width: testCase.width})
+
+        verify(toolbar)
+        verify(waitForRendering(toolbar))
+
+        while (toolbar.visibleWidth == 0) {
+            // Same as above
+            wait(50)
+        }
+
+        const items = Array.from(toolbar.contentItem.children)
+        compare(items.length, 4)
+
+        const actions = [createTemporaryObject(otherAction, testCase), createTemporaryObject(otherAction, testCase)]
+        toolbar.actions = actions
+
+        // Two of the previous full-size items and the more button
+        tryCompare(toolbar.contentItem.children, "length", 3)
+        for (let child of toolbar.contentItem.children) {
+            verify(items.includes(child))
+        }
+        tryVerify(() => toolbar.contentItem.children.filter(child => child.visible && actions.includes(child.action)).length === 2)
+    }
+
+    function test_statistics() {
+        var toolbar = createTemporaryObject(multiple, testCase, {width: testCase.width})
+        verify(toolbar)
+
+        // Accessing the statistics enables them, before the delegates are created
+        const statistics = toolbar.contentItem.statistics
+        verify(statistics)
+
+        verify(waitForRendering(toolbar))
+        while (toolbar.visibleWidth == 0) {
+            // Same as above
+            wait(50)
+        }
+
+        compare(statistics.incubationCount, 3)
+        verify(statistics.implicitSizeCount > 0)
+        verify(statistics.layoutCount > 0)
+        compare(statistics.hiddenCount, 0)
+
+        // Resizing only fits the delegates again
+        statistics.reset()
+        toolbar.width = 50
+        tryCompare(toolbar, "visibleWidth", testCase.iconButton.width)
+        tryVerify(() => statistics.fitCount > 0)
+        compare(statistics.implicitSizeCount, 0)
+        compare(statistics.hiddenCount, 3)
+    }
+
+    // Hiding an action or changing how it is displayed reuses its items, and the layout settles
+    function test_toggle_action() {
+        var toolbar = createTemporaryObject(multiple, testCase, {width: testCase.width})
+        verify(toolbar)
+        const statistics = toolbar.contentItem.statistics
+
+        verify(waitForRendering(toolbar))
+        while (toolbar.visibleWidth == 0) {
+            // Same as above
+            wait(50)
+        }
+
+        const createdItems = () => statistics.incubationCount + statistics.recycledCount
+        const fullWidth = testCase.textIconButton.width * 3 + LingmoUI.Units.smallSpacing * 2
+        const iconWidth = testCase.iconButton.width + testCase.textIconButton.width * 2 + LingmoUI.Units.smallSpacing * 2
+        const action = toolbar.actions[0]
+        compare(createdItems(), 3)
+
+        action.visible = false
+        tryCompare(toolbar, "visibleWidth", testCase.textIconButton.width * 2 + LingmoUI.Units.smallSpacing)
+        action.visible = true
+        tryCompare(toolbar, "visibleWidth", fullWidth)
+        compare(createdItems(), 3)
+
+        // Only the first switch to icon only creates an item
+        action.displayHint = LingmoUI.DisplayHint.IconOnly
+        tryCompare(toolbar, "visibleWidth", iconWidth)
+        compare(createdItems(), 4)
+        action.displayHint = LingmoUI.DisplayHint.NoPreference
+        tryCompare(toolbar, "visibleWidth", fullWidth)
+        action.displayHint = LingmoUI.DisplayHint.IconOnly
+        tryCompare(toolbar, "visibleWidth", iconWidth)
+        compare(createdItems(), 4)
+
+        // Once settled, nothing measures the delegates again
+        verify(waitForRendering(toolbar))
+        const implicitSizeCount = statistics.implicitSizeCount
+        wait(100)
+        compare(statistics.implicitSizeCount, implicitSizeCount)
+
+        // A new text is measured again rather than predicted from the old one
+        action.displayHint = LingmoUI.DisplayHint.NoPreference
+        tryCompare(toolbar, "visibleWidth", fullWidth)
+        action.text = "A Much Longer Test Action"
+        tryVerify(() => toolbar.visibleWidth > fullWidth)
+    }
+
+    // An action that comes back after its items were released is laid out with the width
+    // measured before, creating its item again doesn't measure the delegates again
+    function test_readd_action() {
+        var toolbar = createTemporaryObject(multiple, testCase, {width: testCase.width})
+        verify(toolbar)
+        const statistics = toolbar.contentItem.statistics
+
+        verify(waitForRendering(toolbar))
+        while (toolbar.visibleWidth == 0) {
+            // Same as above
+            wait(50)
+        }
+
+        const actions = Array.from(toolbar.actions)
+        const fullWidth = testCase.textIconButton.width * 3 + LingmoUI.Units.smallSpacing * 2
+        const visibleItem = action => toolbar.contentItem.children.find(child => child.visible && child.action === action)
+
+        // Once the removal timer ran, the item of the removed action is released to the pool
+        toolbar.actions = [actions[1], actions[2]]
+        tryCompare(toolbar, "visibleWidth", testCase.textIconButton.width * 2 + LingmoUI.Units.smallSpacing)
+        wait(1500)
+
+        // Another action takes the released item, so the removed one needs a new item
+        const other = createTemporaryObject(otherAction, testCase)
+        statistics.reset()
+        toolbar.actions = [other, actions[1], actions[2]]
+        tryVerify(() => visibleItem(other) !== undefined)
+        compare(statistics.recycledCount, 1)
+        compare(statistics.incubationCount, 0)
+        const otherWidth = visibleItem(other).width
+
+        verify(waitForRendering(toolbar))
+        statistics.reset()
+        toolbar.actions = [actions[0], other, actions[1], actions[2]]
+        tryVerify(() => visibleItem(actions[0]) !== undefined)
+        tryCompare(toolbar, "visibleWidth", fullWidth + otherWidth + LingmoUI.Units.smallSpacing)
+        compare(statistics.incubationCount, 1)
+        compare(statistics.recycledCount, 0)
+
+        // Only the pass which added the action measured the delegates
+        compare(statistics.implicitSizeCount, 1)
+        verify(waitForRendering(toolbar))
+        compare(statistics.implicitSizeCount, 1)
+    }
 }
@@ -8,6 +8,7 @@ import QtQuick
 import QtQuick.Controls as QQC2
 import org.kde.lingmoui as LingmoUI
 import QtTest
+import LingmoUITestUtils
 
 TestCase {
     name: "ColumnView"
@@ -277,6 +278,252 @@ TestCase {
         compare(two.LingmoUI.ColumnView.index, 2);
     }
 
+    function test_layout_after_changes() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 300, height: 100, columnWidth: 80 });
+        verify(view);
+
+        const items = [];
+        for (let i = 0; i < 4; ++i) {
+            const item = createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` });
+            view.addItem(item);
+            items.push(item);
+        }
+        waitForPolish(view);
+        compare(items.map(item => item.x), [0, 80, 160, 240]);
+
+        const inserted = createTemporaryObject(emptyItemPageComponent, this, { objectName: "inserted" });
+        view.insertItem(2, inserted);
+        waitForPolish(view);
+        compare([...items.slice(0, 2), inserted, ...items.slice(2)].map(item => item.x), [0, 80, 160, 240, 320]);
+        compare(items[3].LingmoUI.ColumnView.index, 4);
+
+        view.removeItem(items[1]);
+        waitForPolish(view);
+        compare([items[0], inserted, items[2], items[3]].map(item => item.x), [0, 80, 160, 240]);
+        compare(items[3].LingmoUI.ColumnView.index, 3);
+
+        view.moveItem(3, 0);
+        waitForPolish(view);
+        compare([items[3], items[0], inserted, items[2]].map(item => item.x), [0, 80, 160, 240]);
+    }
+
+    function test_attached_changes() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 300, height: 100, columnWidth: 80 });
+        verify(view);
+
+        const items = [];
+        for (let i = 0; i < 3; ++i) {
+            const item = createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` });
+            view.addItem(item);
+            items.push(item);
+        }
+        waitForPolish(view);
+        compare(items.map(item => item.x), [0, 80, 160]);
+
+        items[1].LingmoUI.ColumnView.reservedSpace = 100;
+        items[1].LingmoUI.ColumnView.fillWidth = true;
+        waitForPolish(view);
+        compare(items[1].width, 200);
+        compare(items[2].x, 280);
+
+        items[1].LingmoUI.ColumnView.reservedSpace = 150;
+        waitForPolish(view);
+        compare(items[2].x, 230);
+
+        items[1].LingmoUI.ColumnView.fillWidth = false;
+        waitForPolish(view);
+        compare(items[2].x, 160);
+    }
+
+    function test_visible_items() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 200, height: 100, columnWidth: 100, scrollDuration: 0 });
+        verify(view);
+
+        const items = [];
+        for (let i = 0; i < 5; ++i) {
+            const item = createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` });
+            view.addItem(item);
+            items.push(item);
+        }
+        waitForPolish(view);
+
+        view.contentX = 0;
+        compare(view.visibleItems, [items[0], items[1]]);
+        compare(view.leadingVisibleItem, items[0]);
+        compare(view.trailingVisibleItem, items[1]);
+        verify(items[1].LingmoUI.ColumnView.inViewport);
+        verify(items[1].enabled);
+        verify(!items[2].LingmoUI.ColumnView.inViewport);
+        verify(!items[2].enabled);
+
+        view.contentX = 150;
+        compare(view.visibleItems, [items[1], items[2], items[3]]);
+        verify(!items[0].LingmoUI.ColumnView.inViewport);
+        verify(!items[0].enabled);
+        verify(items[3].LingmoUI.ColumnView.inViewport);
+        verify(items[3].enabled);
+
+        view.removeItem(items[2]);
+        waitForPolish(view);
+        verify(!view.visibleItems.includes(items[2]));
+    }
+
+    function test_virtualize_columns() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 200, height: 100, columnWidth: 100, scrollDuration: 0 });
+        verify(view);
+
+        const items = [];
+        for (let i = 0; i < 5; ++i) {
+            const item = createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` });
+            view.addItem(item);
+            items.push(item);
+        }
+        waitForPolish(view);
+        view.contentX = 0;
+
+        const culled = item => ItemHelper.isCulled(item);
+
+        view.virtualizeColumns = true;
+        compare(items.map(culled), [false, false, true, true, true]);
+        // Culled columns stay visible and keep their place in the layout
+        compare(items.map(item => item.visible), [true, true, true, true, true]);
+        compare(items[4].x, 400);
+        compare(view.contentWidth, 500);
+
+        view.contentX = 300;
+        compare(items.map(culled), [true, true, true, false, false]);
+        compare(view.visibleItems, [items[3], items[4]]);
+
+        view.virtualizationDistance = 100;
+        compare(items.map(culled), [true, true, false, false, false]);
+
+        // Hiding a culled column is left to the user, virtualization doesn't show it again
+        items[0].visible = false;
+        waitForPolish(view);
+        view.contentX = 0;
+        verify(!items[0].visible);
+
+        view.virtualizeColumns = false;
+        compare(items.map(culled), [false, false, false, false, false]);
+        compare(items.map(item => item.visible), [false, true, true, true, true]);
+    }
+
+    function test_threaded_scroll_animation() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 200, height: 100, columnWidth: 100, scrollDuration: 50, threadedScrollAnimation: true });
+        verify(view);
+
+        for (let i = 0; i < 5; ++i) {
+            view.addItem(createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` }));
+        }
+        waitForPolish(view);
+        view.contentX = 0;
+
+        view.currentIndex = 4;
+        tryCompare(view, "moving", false);
+        compare(view.contentX, 300);
+    }
+
+    function test_statistics() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 200, height: 100, columnWidth: 100, scrollDuration: 0 });
+        verify(view);
+        const statistics = view.statistics;
+        verify(statistics);
+
+        for (let i = 0; i < 3; ++i) {
+            view.addItem(createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` }));
+        }
+        waitForPolish(view);
+        verify(statistics.layoutCount > 0);
+        verify(statistics.visibleItemsCount > 0);
+        verify(statistics.layoutTime >= 0);
+
+        statistics.reset();
+        compare(statistics.layoutCount, 0);
+        compare(statistics.layoutTime, 0);
+
+        view.contentX = 100;
+        compare(statistics.layoutCount, 0);
+        verify(statistics.visibleItemsCount > 0);
+    }
+
+    function test_deferred_items() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 200, height: 100, columnWidth: 100, scrollDuration: 0 });
+        verify(view);
+
+        const first = createTemporaryObject(emptyItemPageComponent, this, { objectName: "first" });
+        view.addItem(first);
+        view.currentIndex = 0;
+
+        const components = [];
+        const properties = [];
+        for (let i = 0; i < 4; ++i) {
+            components.push(emptyItemPageComponent);
+            properties.push({ objectName: `deferred${i}` });
+        }
+        view.insertDeferredItems(1, components, properties);
+        compare(view.count, 5);
+        compare(view.currentItem, first);
+        waitForPolish(view);
+
+        // Only the column sharing the viewport with the first one has been created
+        compare(view.contentChildren.map(item => item.objectName), ["first", "deferred0", "", "", ""]);
+        compare(view.contentChildren[4].x, 400);
+
+        view.contentX = 300;
+        waitForPolish(view);
+        compare(view.contentChildren.map(item => item.objectName), ["first", "deferred0", "", "deferred2", "deferred3"]);
+        compare(view.currentItem, first);
+        compare(view.contentChildren[3].LingmoUI.ColumnView.index, 3);
+    }
+
+    function test_pinned_columns() {
+        const view = createTemporaryObject(columnViewComponent, this, { width: 200, height: 100, columnWidth: 100, scrollDuration: 0 });
+        verify(view);
+
+        const items = [];
+        for (let i = 0; i < 5; ++i) {
+            const item = createTemporaryObject(emptyItemPageComponent, this, { objectName: `item${i}` });
+            view.addItem(item);
+            items.push(item);
+        }
+        items[0].LingmoUI.ColumnView.pinned = true;
+        waitForPolish(view);
+        view.contentX = 0;
+        compare(items[0].x, 0);
+
+        // The pinned column follows contentX, the others stay where they are
+        view.contentX = 150;
+        waitForPolish(view);
+        compare(items[0].x, 150);
+        compare(items.slice(1).map(item => item.x), [100, 200, 300, 400]);
+
+        verify(waitForRendering(view));
+        const image = grabImage(view);
+        const background = image.pixel(120, 50);
+        // The trailing separator of the pinned column, at the left of the view
+        verify(!Qt.colorEqual(image.pixel(99, 50), background));
+        // The column under the pinned one doesn't draw its separator over it
+        verify(Qt.colorEqual(image.pixel(50, 50), background));
+        // The next column draws its own, once
+        verify(!Qt.colorEqual(image.pixel(150, 50), background));
+
+        view.contentX = 0;
+        waitForPolish(view);
+        compare(items[0].x, 0);
+        compare(items[1].x, 100);
+    }
+
+    function test_separators_are_not_items() {
+        const { view, zero, one, two } = createViewWith3Items();
+        verify(view.separatorVisible);
+        waitForPolish(view);
+
+        // Separators are drawn by the view itself, columns don't get any extra child
+        compare(zero.children.length, 0);
+        compare(one.children.length, 0);
+        compare(two.children.length, 0);
+    }
+
     component Filler : Rectangle {
         z: 1
         opacity: 0.2
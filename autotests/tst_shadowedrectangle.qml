@@ -0,0 +1,122 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQuick
+import org.kde.lingmoui.primitives as LingmoUIPrimitives
+import QtTest
+
+TestCase {
+    id: root
+
+    name: "ShadowedRectangleTest"
+    visible: true
+    when: windowShown
+
+    width: 300
+    height: 300
+
+    // Makes every frame miss its budget while true. This runs between the
+    // synchronization and the end of rendering, which is what is measured,
+    // as long as rendering happens on the GUI thread (QSG_RENDER_LOOP=basic).
+    property bool slowFrames: false
+
+    Connections {
+        target: root.Window.window
+        function onBeforeRendering() {
+            if (!root.slowFrames) {
+                return;
+            }
+            const end = Date.now() + 30;
+            while (Date.now() < end) {
+            }
+        }
+    }
+
+    Component {
+        id: rectangleComponent
+        LingmoUIPrimitives.ShadowedRectangle {
+            width: 100
+            height: 100
+            color: "white"
+            shadow.size: 10
+            renderType: LingmoUIPrimitives.ShadowedRectangle.Adaptive
+        }
+    }
+
+    // Something to keep frames coming
+    Rectangle {
+        id: spinner
+        width: 10
+        height: 10
+        RotationAnimation on rotation {
+            running: root.slowFrames
+            loops: Animation.Infinite
+            from: 0
+            to: 360
+            duration: 1000
+        }
+    }
+
+    function cleanup() {
+        slowFrames = false;
+    }
+
+    QtObject {
+        id: boundStatistics
+        readonly property real nodesCreated: LingmoUIPrimitives.RenderStatistics.nodesCreated
+        readonly property real materialUploads: LingmoUIPrimitives.RenderStatistics.materialUploads
+    }
+
+    function test_renderStatistics() {
+        const statistics = LingmoUIPrimitives.RenderStatistics;
+        statistics.reset();
+        compare(statistics.nodesCreated, 0);
+        compare(boundStatistics.nodesCreated, 0);
+
+        const rectangle = createTemporaryObject(rectangleComponent, root);
+        verify(rectangle);
+        verify(waitForRendering(rectangle));
+        verify(statistics.nodesCreated > 0);
+        verify(statistics.materialUploads > 0);
+
+        // Bindings follow, a bit later
+        tryVerify(() => boundStatistics.nodesCreated > 0, 3000);
+        compare(boundStatistics.materialUploads, statistics.materialUploads);
+
+        // Redrawing without any change reuses the node
+        const nodesCreated = statistics.nodesCreated;
+        rectangle.color = "black";
+        verify(waitForRendering(rectangle));
+        compare(statistics.nodesCreated, nodesCreated);
+    }
+
+    function test_default() {
+        const rectangle = createTemporaryObject(rectangleComponent, root, { renderType: LingmoUIPrimitives.ShadowedRectangle.Auto });
+        verify(rectangle);
+        verify(waitForRendering(rectangle));
+        verify(!rectangle.qualityReduced);
+    }
+
+    function test_adaptive() {
+        const rectangle = createTemporaryObject(rectangleComponent, root);
+        verify(rectangle);
+        verify(waitForRendering(rectangle));
+        verify(!rectangle.qualityReduced);
+
+        slowFrames = true;
+        tryVerify(() => rectangle.qualityReduced, 10000);
+
+        // Switching away from Adaptive doesn't keep the reduced quality
+        rectangle.renderType = LingmoUIPrimitives.ShadowedRectangle.Auto;
+        verify(!rectangle.qualityReduced);
+        rectangle.renderType = LingmoUIPrimitives.ShadowedRectangle.Adaptive;
+        verify(rectangle.qualityReduced);
+
+        // An idle window renders nothing, which restores the quality after a while
+        slowFrames = false;
+        tryVerify(() => !rectangle.qualityReduced, 5000);
+    }
+}
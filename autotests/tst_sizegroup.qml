@@ -0,0 +1,100 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtTest
+import org.kde.lingmoui as LingmoUI
+
+TestCase {
+    id: root
+
+    name: "SizeGroupTest"
+    visible: true
+    when: windowShown
+
+    width: 400
+    height: 400
+
+    component CountingRectangle: Rectangle {
+        // How often the SizeGroup wrote the preferred width
+        property int widthWrites: 0
+        property int heightWrites: 0
+
+        implicitHeight: 20
+        Layout.onPreferredWidthChanged: widthWrites++
+        Layout.onPreferredHeightChanged: heightWrites++
+    }
+
+    Component {
+        id: groupComponent
+        RowLayout {
+            readonly property alias group: group
+            readonly property alias first: first
+            readonly property alias second: second
+
+            LingmoUI.SizeGroup {
+                id: group
+                mode: LingmoUI.SizeGroup.Width
+                items: [first, second]
+            }
+
+            CountingRectangle {
+                id: first
+                implicitWidth: 50
+            }
+            CountingRectangle {
+                id: second
+                implicitWidth: 100
+            }
+        }
+    }
+
+    function createGroup() {
+        const layout = createTemporaryObject(groupComponent, root);
+        verify(layout);
+        // Let the adjustment queued while adding the items run
+        wait(0);
+        compare(layout.first.Layout.preferredWidth, 100);
+        compare(layout.second.Layout.preferredWidth, 100);
+        return layout;
+    }
+
+    // Several size changes in a row are applied in a single pass
+    function test_coalescing() {
+        const layout = createGroup();
+        const firstWrites = layout.first.widthWrites;
+        const secondWrites = layout.second.widthWrites;
+
+        layout.first.implicitWidth = 120;
+        layout.first.implicitWidth = 150;
+        layout.second.implicitWidth = 130;
+        compare(layout.first.Layout.preferredWidth, 100);
+
+        tryCompare(layout.first.Layout, "preferredWidth", 150);
+        compare(layout.second.Layout.preferredWidth, 150);
+        compare(layout.first.widthWrites, firstWrites + 1);
+        compare(layout.second.widthWrites, secondWrites + 1);
+    }
+
+    // What is up to date is not written again, relayout() writes it anyway
+    function test_redundantWrites() {
+        const layout = createGroup();
+
+        // Neither a smaller item nor a dimension the group doesn't sync changes the result
+        layout.first.Layout.preferredWidth = 10;
+        layout.first.implicitWidth = 60;
+        layout.second.implicitHeight = 40;
+        wait(50);
+        compare(layout.first.Layout.preferredWidth, 10);
+        compare(layout.first.heightWrites, 0);
+        compare(layout.second.heightWrites, 0);
+
+        layout.group.relayout();
+        compare(layout.first.Layout.preferredWidth, 100);
+        compare(layout.first.heightWrites, 0);
+    }
+}
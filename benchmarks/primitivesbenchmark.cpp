@@ -0,0 +1,461 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+/*
+ * Offscreen rendering benchmark for the types in org.kde.lingmoui.primitives.
+ *
+ * This renders a grid of ShadowedRectangle, ShadowedTexture or Icon items
+ * through QQuickRenderControl, either with the software backend or with the
+ * null RHI backend, and reports the wall-clock time spent in the sync and
+ * render phases of each frame. Neither backend needs a GPU, so this can run on CI
+ * using the offscreen platform plugin.
+ */
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickImageProvider>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickRenderTarget>
+#include <QQuickWindow>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#define HAVE_RHI_RENDER_TARGET 1
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+struct Options {
+    bool software = false;
+    int items = 100;
+    int frames = 100;
+    int warmupFrames = 10;
+    bool animate = true;
+    QStringList importPaths;
+};
+
+struct FrameResult {
+    qint64 syncTime = 0;
+    qint64 renderTime = 0;
+    int batches = -1;
+    int batchedNodes = -1;
+};
+
+struct ScenarioResult {
+    std::vector<FrameResult> frames;
+    qint64 nodesCreated = 0;
+    qint64 materialUploads = 0;
+    qint64 geometryUploads = 0;
+};
+
+// The batch renderer reports the batches it rendered when QSG_RENDERER_DEBUG
+// contains "render". There is no public API for this information, so parse
+// the debug output instead.
+static FrameResult *s_currentFrame = nullptr;
+static QtMessageHandler s_previousMessageHandler = nullptr;
+
+static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type != QtDebugMsg) {
+        s_previousMessageHandler(type, context, message);
+        return;
+    }
+
+    static const QRegularExpression batchExpression(QStringLiteral("-> (?:Opaque|Alpha): (\\d+) nodes in (\\d+) batches"));
+
+    auto matches = batchExpression.globalMatch(message);
+    while (s_currentFrame && matches.hasNext()) {
+        const auto match = matches.next();
+        s_currentFrame->batchedNodes = std::max(s_currentFrame->batchedNodes, 0) + match.captured(1).toInt();
+        s_currentFrame->batches = std::max(s_currentFrame->batches, 0) + match.captured(2).toInt();
+    }
+
+    // Drop all other debug output of the renderer, it would drown the results.
+}
+
+class TileImageProvider : public QQuickImageProvider
+{
+public:
+    TileImageProvider()
+        : QQuickImageProvider(QQuickImageProvider::Image)
+    {
+    }
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override
+    {
+        Q_UNUSED(id)
+
+        const QSize imageSize = requestedSize.isValid() ? requestedSize : QSize(32, 32);
+        QImage image(imageSize, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.fillRect(0, 0, imageSize.width() / 2, imageSize.height() / 2, Qt::darkCyan);
+        painter.fillRect(imageSize.width() / 2, imageSize.height() / 2, imageSize.width() / 2, imageSize.height() / 2, Qt::darkCyan);
+        painter.end();
+
+        if (size) {
+            *size = imageSize;
+        }
+        return image;
+    }
+};
+
+static QString delegateSource(const QString &type)
+{
+    if (type == QStringLiteral("rectangle")) {
+        return QStringLiteral(R"(
+            Primitives.ShadowedRectangle {
+                required property int index
+                width: 32
+                height: 32
+                radius: 2 + (root.phase + index) % 8
+                color: "steelblue"
+                shadow.size: 6
+                shadow.yOffset: 2
+                border.width: index % 2
+                border.color: "black"
+            }
+        )");
+    } else if (type == QStringLiteral("texture")) {
+        return QStringLiteral(R"(
+            Primitives.ShadowedTexture {
+                required property int index
+                width: 32
+                height: 32
+                radius: 2 + (root.phase + index) % 8
+                shadow.size: 6
+                shadow.yOffset: 2
+                source: Image {
+                    source: "image://benchmark/tile"
+                    sourceSize.width: 32
+                    sourceSize.height: 32
+                    opacity: 0
+                }
+            }
+        )");
+    } else if (type == QStringLiteral("icon")) {
+        return QStringLiteral(R"(
+            Primitives.Icon {
+                required property int index
+                width: 32
+                height: 32
+                source: index % 2 ? "document-new" : "edit-copy"
+                opacity: 0.5 + ((root.phase + index) % 2) * 0.5
+            }
+        )");
+    }
+
+    return QString{};
+}
+
+static constexpr int itemSize = 32;
+static constexpr int itemSpacing = 8;
+
+static int gridColumns(int items)
+{
+    return std::max(1, int(std::ceil(std::sqrt(double(items)))));
+}
+
+static QString sceneSource(const QString &type, int items)
+{
+    const int columns = gridColumns(items);
+
+    return QStringLiteral(R"(
+        import QtQuick
+        import org.kde.lingmoui.primitives as Primitives
+
+        Grid {
+            id: root
+
+            property int phase: 0
+
+            columns: %1
+            spacing: %4
+
+            Repeater {
+                model: %2
+                delegate: %3
+            }
+        }
+    )")
+        .arg(columns)
+        .arg(items)
+        .arg(delegateSource(type))
+        .arg(itemSpacing);
+}
+
+static QObject *renderStatistics(QQmlEngine *engine)
+{
+    return engine->singletonInstance<QObject *>("org.kde.lingmoui.primitives", "RenderStatistics");
+}
+
+static bool runScenario(const Options &options, const QString &type, ScenarioResult &result)
+{
+    QQmlEngine engine;
+    for (const auto &path : options.importPaths) {
+        engine.addImportPath(path);
+    }
+    engine.addImageProvider(QStringLiteral("benchmark"), new TileImageProvider);
+
+    QQuickRenderControl renderControl;
+    QQuickWindow window(&renderControl);
+
+    QQmlComponent component(&engine);
+    component.setData(sceneSource(type, options.items).toUtf8(), QUrl(QStringLiteral("primitivesbenchmark.qml")));
+    if (component.isError()) {
+        qWarning() << component.errors();
+        return false;
+    }
+
+    std::unique_ptr<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    if (!root) {
+        qWarning() << "Could not create scene for" << type;
+        return false;
+    }
+
+    root->setParentItem(window.contentItem());
+
+    // The grid only calculates its size when polished, so calculate it here
+    // to be able to set up the render target before the first frame.
+    const int columns = gridColumns(options.items);
+    const int rows = (options.items + columns - 1) / columns;
+    const QSize size(columns * (itemSize + itemSpacing), rows * (itemSize + itemSpacing));
+    window.resize(size);
+    window.contentItem()->setSize(size);
+
+    if (!renderControl.initialize()) {
+        qWarning() << "Could not initialize render control";
+        return false;
+    }
+
+    QImage softwareTarget;
+#ifdef HAVE_RHI_RENDER_TARGET
+    std::unique_ptr<QRhiTexture> texture;
+    std::unique_ptr<QRhiTextureRenderTarget> renderTarget;
+    std::unique_ptr<QRhiRenderPassDescriptor> renderPass;
+#endif
+
+    if (options.software) {
+        softwareTarget = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        window.setRenderTarget(QQuickRenderTarget::fromPaintDevice(&softwareTarget));
+    } else {
+#ifdef HAVE_RHI_RENDER_TARGET
+        QRhi *rhi = renderControl.rhi();
+        texture.reset(rhi->newTexture(QRhiTexture::RGBA8, size, 1, QRhiTexture::RenderTarget));
+        texture->create();
+        renderTarget.reset(rhi->newTextureRenderTarget(QRhiTextureRenderTargetDescription(QRhiColorAttachment(texture.get()))));
+        renderPass.reset(renderTarget->newCompatibleRenderPassDescriptor());
+        renderTarget->setRenderPassDescriptor(renderPass.get());
+        renderTarget->create();
+        window.setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(renderTarget.get()));
+#endif
+    }
+
+    auto statistics = renderStatistics(&engine);
+    if (statistics) {
+        QMetaObject::invokeMethod(statistics, "reset");
+    }
+
+    result.frames.reserve(options.frames);
+
+    QElapsedTimer timer;
+    for (int frame = 0; frame < options.warmupFrames + options.frames; ++frame) {
+        const bool measured = frame >= options.warmupFrames;
+
+        // Resetting the counters after the warm up means the results only
+        // contain work done for updates, not for initial node creation.
+        if (frame == options.warmupFrames && statistics) {
+            QMetaObject::invokeMethod(statistics, "reset");
+        }
+
+        if (options.animate) {
+            root->setProperty("phase", frame);
+        }
+
+        FrameResult frameResult;
+        s_currentFrame = &frameResult;
+
+        renderControl.polishItems();
+        if (!options.software) {
+            renderControl.beginFrame();
+        }
+
+        timer.start();
+        renderControl.sync();
+        frameResult.syncTime = timer.nsecsElapsed();
+
+        timer.start();
+        renderControl.render();
+        frameResult.renderTime = timer.nsecsElapsed();
+
+        if (!options.software) {
+            renderControl.endFrame();
+        }
+
+        s_currentFrame = nullptr;
+
+        if (measured) {
+            result.frames.push_back(frameResult);
+        }
+
+        QCoreApplication::processEvents();
+    }
+
+    if (statistics) {
+        result.nodesCreated = statistics->property("nodesCreated").toLongLong();
+        result.materialUploads = statistics->property("materialUploads").toLongLong();
+        result.geometryUploads = statistics->property("geometryUploads").toLongLong();
+    }
+
+    window.setRenderTarget(QQuickRenderTarget{});
+    return true;
+}
+
+static double median(std::vector<qint64> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    std::sort(values.begin(), values.end());
+    const auto middle = values.size() / 2;
+    if (values.size() % 2 == 0) {
+        return (values[middle - 1] + values[middle]) / 2.0;
+    }
+    return values[middle];
+}
+
+static void printResult(QTextStream &stream, const QString &type, const ScenarioResult &result)
+{
+    std::vector<qint64> syncTimes;
+    std::vector<qint64> renderTimes;
+    for (const auto &frame : result.frames) {
+        syncTimes.push_back(frame.syncTime);
+        renderTimes.push_back(frame.renderTime);
+    }
+
+    const double frameCount = std::max(result.frames.size(), size_t(1));
+    const double syncMean = std::accumulate(syncTimes.begin(), syncTimes.end(), 0.0) / frameCount;
+    const double renderMean = std::accumulate(renderTimes.begin(), renderTimes.end(), 0.0) / frameCount;
+
+    // Batch information is only available from the batch renderer, so not
+    // when using the software backend.
+    const FrameResult last = result.frames.empty() ? FrameResult{} : result.frames.back();
+    const auto batches = last.batches >= 0 ? QString::number(last.batches) : QStringLiteral("-");
+    const auto batchedNodes = last.batchedNodes >= 0 ? QString::number(last.batchedNodes) : QStringLiteral("-");
+
+    stream << qSetFieldWidth(12) << Qt::left << type << Qt::right //
+           << QString::number(syncMean / 1000.0, 'f', 1) << QString::number(median(syncTimes) / 1000.0, 'f', 1)
+           << QString::number(renderMean / 1000.0, 'f', 1) << QString::number(median(renderTimes) / 1000.0, 'f', 1) //
+           << batches << batchedNodes //
+           << result.nodesCreated << result.materialUploads << result.geometryUploads << qSetFieldWidth(0) << Qt::endl;
+}
+
+int main(int argc, char **argv)
+{
+    // Everything is rendered offscreen, so don't require a display.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    qputenv("QSG_RENDERER_DEBUG", "render");
+
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Offscreen rendering benchmark for LingmoUI primitives."));
+    parser.addHelpOption();
+
+    QCommandLineOption backendOption(QStringLiteral("backend"), QStringLiteral("Scene graph backend, either software or null."), QStringLiteral("backend"));
+    backendOption.setDefaultValue(QStringLiteral("null"));
+    parser.addOption(backendOption);
+
+    QCommandLineOption itemsOption(QStringLiteral("items"), QStringLiteral("Number of items to render per scenario."), QStringLiteral("count"));
+    itemsOption.setDefaultValue(QStringLiteral("100"));
+    parser.addOption(itemsOption);
+
+    QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Number of frames to measure."), QStringLiteral("count"));
+    framesOption.setDefaultValue(QStringLiteral("100"));
+    parser.addOption(framesOption);
+
+    QCommandLineOption typeOption(QStringLiteral("type"),
+                                  QStringLiteral("Type of item to render, one of rectangle, texture or icon. Can be repeated, defaults to all."),
+                                  QStringLiteral("type"));
+    parser.addOption(typeOption);
+
+    QCommandLineOption staticOption(QStringLiteral("static"), QStringLiteral("Do not change item properties between frames."));
+    parser.addOption(staticOption);
+
+    QCommandLineOption importOption(QStringLiteral("import"), QStringLiteral("Additional QML import path."), QStringLiteral("path"));
+    parser.addOption(importOption);
+
+    parser.process(app);
+
+    Options options;
+    options.software = parser.value(backendOption) == QStringLiteral("software");
+    options.items = std::max(parser.value(itemsOption).toInt(), 1);
+    options.frames = std::max(parser.value(framesOption).toInt(), 1);
+    options.animate = !parser.isSet(staticOption);
+    options.importPaths = parser.values(importOption);
+
+    if (!options.software && parser.value(backendOption) != QStringLiteral("null")) {
+        qWarning() << "Unknown backend" << parser.value(backendOption);
+        return 1;
+    }
+
+    if (options.software) {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    } else {
+#ifdef HAVE_RHI_RENDER_TARGET
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+#else
+        QTextStream(stdout) << "The null backend requires Qt 6.6 or newer, skipping." << Qt::endl;
+        return 0;
+#endif
+    }
+
+    QStringList types = parser.values(typeOption);
+    if (types.isEmpty()) {
+        types = {QStringLiteral("rectangle"), QStringLiteral("texture"), QStringLiteral("icon")};
+    }
+
+    s_previousMessageHandler = qInstallMessageHandler(messageHandler);
+
+    QTextStream stream(stdout);
+    stream << "Backend: " << parser.value(backendOption) << ", items: " << options.items << ", frames: " << options.frames << Qt::endl;
+    stream << "Times are wall-clock time per frame in microseconds." << Qt::endl;
+    stream << qSetFieldWidth(12) << Qt::left << "type" << Qt::right //
+           << "sync" << "sync med" << "render" << "render med" << "batches" << "nodes" //
+           << "created" << "material" << "geometry" << qSetFieldWidth(0) << Qt::endl;
+
+    for (const auto &type : std::as_const(types)) {
+        if (delegateSource(type).isEmpty()) {
+            qWarning() << "Unknown type" << type;
+            return 1;
+        }
+
+        ScenarioResult result;
+        if (!runScenario(options, type, result)) {
+            return 1;
+        }
+        printResult(stream, type, result);
+    }
+
+    return 0;
+}
@@ -84,6 +84,17 @@ LingmoUI.Action {
      * @since org.kde.lingmoui 2.12
      */
     property bool useLayers: false
+
+    /**
+     * @brief This property sets whether the page is created without blocking the user interface.
+     *
+     * When true, the page is loaded with PagePool::loadPageAsync() and pushed once it is ready.
+     * Meanwhile, PagePool::loading and PagePool::loadingProgress can be used to show a placeholder.
+     *
+     * default: ``false``
+     * @since 6.5
+     */
+    property bool asynchronous: false
 //END properties
 
     /**
@@ -154,7 +165,7 @@ LingmoUI.Action {
             return;
         }
 
-        if (pagePool.isLocalUrl(page)) {
+        if (pagePool.isLocalUrl(page) && !asynchronous) {
             if (basePage) {
                 stack.pop(basePage);
 
@@ -177,7 +188,10 @@ LingmoUI.Action {
                 stack.push(item);
             };
 
-            if (initialProperties) {
+            if (asynchronous) {
+                pagePool.loadPageAsync(page, initialProperties || {}, callback);
+
+            } else if (initialProperties) {
                 pagePool.loadPage(page, initialProperties, callback);
 
             } else {
@@ -229,6 +229,50 @@ QT.Control {
         return item
     }
 
+    /**
+     * @brief This method pushes several pages at once, creating them only when they are shown.
+     *
+     * It behaves like push() with an array of pages, except that the pages
+     * given as an url or a component are only instantiated the first time
+     * they become visible. Until then, an empty placeholder item takes their
+     * place. The last page becomes the current one and is created right away.
+     * This keeps restoring a deep navigation path from blocking the first frame.
+     *
+     * Placeholders are plain Items without the Page API: until they are
+     * created they show up in items, get() and pageInserted like any page, so
+     * code iterating over the pages must not assume every entry is a Page.
+     * When a page gets created, pageRemoved is emitted for its placeholder,
+     * followed by pageInserted for the page at the same index. A page that
+     * fails to be created is removed from the row.
+     *
+     * @param pages An array of pages.
+     * @param properties An array of property objects matching the pages, or
+     * a single property object for the last page.
+     *
+     * @return The last page, which is created immediately.
+     * @since 6.5
+     */
+    function pushDeferred(pages, properties): QT.Page {
+        if (!Array.isArray(pages) || !pagesLogic.verifyPages(pages, properties)) {
+            console.warn("Pushed pages do not conform to the rules. Please check the documentation.");
+            console.trace();
+            return null
+        }
+
+        const position = currentIndex + 1
+        const last = pages.length - 1
+        const propsArray = Array.isArray(properties) ? properties : []
+        columnView.pop(position - 1);
+
+        const deferredPages = pages.slice(0, last)
+            .map((page, i) => pagesLogic.getPageComponent(page) ?? pagesLogic.initPage(page, propsArray[i]))
+        columnView.insertDeferredItems(position, deferredPages, propsArray.slice(0, last));
+
+        const item = pagesLogic.insertPage_unchecked(position + last, pages[last], Array.isArray(properties) ? properties[last] : properties)
+        currentIndex = depth - 1
+        return item
+    }
+
     /**
      * @brief Pushes a page as a new dialog on desktop and as a layer on mobile.
      *
@@ -7,6 +7,7 @@
 #include "columnview.h"
 #include "columnview_p.h"
 
+#include "columnviewlogging.h"
 #include "loggingcategory.h"
 #include <QAbstractItemModel>
 #include <QGuiApplication>
@@ -14,8 +15,14 @@
 #include <QQmlComponent>
 #include <QQmlContext>
 #include <QQmlEngine>
+#include <QQuickWindow>
+#include <QSGRectangleNode>
 #include <QStyleHints>
+#include <QVarLengthArray>
+#include <QtQuick/private/qquickitem_p.h>
 
+#include "platform/colorutils.h"
+#include "platform/platformtheme.h"
 #include "platform/units.h"
 
 class QmlComponentsPoolSingleton
@@ -32,6 +39,8 @@ private:
 
 Q_GLOBAL_STATIC(QmlComponentsPoolSingleton, privateQmlComponentsPoolSelf)
 
+using ColumnViewTimer = LayoutTimer<LingmoUIColumnViewLog>;
+
 QmlComponentsPool *QmlComponentsPoolSingleton::instance(QQmlEngine *engine)
 {
     Q_ASSERT(engine);
@@ -58,73 +67,180 @@ QmlComponentsPool *QmlComponentsPoolSingleton::instance(QQmlEngine *engine)
 
 QmlComponentsPool::QmlComponentsPool(QQmlEngine *engine)
     : QObject(engine)
+    , m_engine(engine)
 {
-    QQmlComponent component(engine);
+    m_units = engine->singletonInstance<LingmoUI::Platform::Units *>("org.kde.lingmoui.platform", "Units");
+    Q_ASSERT(m_units);
 
-    /* clang-format off */
-    component.setData(QByteArrayLiteral(R"(
-import QtQuick
-import org.kde.lingmoui as LingmoUI
+    connect(m_units, &LingmoUI::Platform::Units::gridUnitChanged, this, &QmlComponentsPool::gridUnitChanged);
+    connect(m_units, &LingmoUI::Platform::Units::longDurationChanged, this, &QmlComponentsPool::longDurationChanged);
+    connect(m_units, &LingmoUI::Platform::Units::largeSpacingChanged, this, &QmlComponentsPool::largeSpacingChanged);
+}
 
-QtObject {
-    readonly property Component leadingSeparator: LingmoUI.Separator {
-        property Item column
-        property bool inToolBar
-        property LingmoUI.ColumnView view
+QmlComponentsPool::~QmlComponentsPool()
+{
+}
 
-        // positioning trick to hide the very first separator
-        visible: {
-            if (!view || !view.separatorVisible) {
-                return false;
-            }
+QQmlComponent *QmlComponentsPool::slideAnimatorComponent()
+{
+    if (!m_slideAnimatorComponent) {
+        m_slideAnimatorComponent = new QQmlComponent(m_engine, this);
 
-            return view && (LayoutMirroring.enabled
-                ? view.contentX + view.width > column.x + column.width
-                : view.contentX < column.x);
+        /* clang-format off */
+        m_slideAnimatorComponent->setData(QByteArrayLiteral(R"(
+import QtQuick
+
+XAnimator {
+    easing.type: Easing.OutExpo
+}
+)"), QUrl(QStringLiteral("columnview.cpp")));
+        /* clang-format on */
+
+        if (m_slideAnimatorComponent->isError()) {
+            qCWarning(LingmoUILayoutsLog) << m_slideAnimatorComponent->errors();
         }
+    }
+
+    return m_slideAnimatorComponent;
+}
+
+/////////
+
+ColumnSeparators::ColumnSeparators(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents);
+}
 
-        anchors.top: column.top
-        anchors.left: column.left
-        anchors.bottom: column.bottom
-        anchors.topMargin: inToolBar ? LingmoUI.Units.largeSpacing : 0
-        anchors.bottomMargin: inToolBar ? LingmoUI.Units.largeSpacing : 0
-        LingmoUI.Theme.colorSet: LingmoUI.Theme.Header
-        LingmoUI.Theme.inherit: false
+ColumnSeparators::~ColumnSeparators()
+{
+}
+
+void ColumnSeparators::setSeparators(const QList<QRectF> &rects)
+{
+    if (rects == m_rects) {
+        return;
     }
 
-    readonly property Component trailingSeparator: LingmoUI.Separator {
-        property Item column
+    m_rects = rects;
+    update();
+}
 
-        anchors.top: column.top
-        anchors.right: column.right
-        anchors.bottom: column.bottom
-        LingmoUI.Theme.colorSet: LingmoUI.Theme.Header
-        LingmoUI.Theme.inherit: false
+void ColumnSeparators::updateColor()
+{
+    // Same color as LingmoUI.Separator with the Header color set
+    LingmoUI::Platform::ColorUtils colorUtils;
+    const QColor color = colorUtils.linearInterpolation(m_theme->backgroundColor(), m_theme->textColor(), m_theme->frameContrast());
+    if (color == m_color) {
+        return;
     }
+
+    m_color = color;
+    update();
 }
-)"), QUrl(QStringLiteral("columnview.cpp")));
-    /* clang-format on */
 
-    m_instance = component.create();
-    // qCWarning(LingmoUILayoutsLog)<<component.errors();
-    Q_ASSERT(m_instance);
-    m_instance->setParent(this);
+void ColumnSeparators::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
+{
+    if (change == QQuickItem::ItemSceneChange && value.window && !m_theme) {
+        m_theme = static_cast<LingmoUI::Platform::PlatformTheme *>(qmlAttachedPropertiesObject<LingmoUI::Platform::PlatformTheme>(this, true));
+        Q_ASSERT(m_theme);
+        m_theme->setColorSet(LingmoUI::Platform::PlatformTheme::Header);
+        m_theme->setInherit(false);
 
-    m_leadingSeparatorComponent = m_instance->property("leadingSeparator").value<QQmlComponent *>();
-    Q_ASSERT(m_leadingSeparatorComponent);
+        connect(m_theme, &LingmoUI::Platform::PlatformTheme::colorsChanged, this, &ColumnSeparators::updateColor);
+        updateColor();
+    }
 
-    m_trailingSeparatorComponent = m_instance->property("trailingSeparator").value<QQmlComponent *>();
-    Q_ASSERT(m_trailingSeparatorComponent);
+    QQuickItem::itemChange(change, value);
+}
 
-    m_units = engine->singletonInstance<LingmoUI::Platform::Units *>("org.kde.lingmoui.platform", "Units");
-    Q_ASSERT(m_units);
+QSGNode *ColumnSeparators::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
 
-    connect(m_units, &LingmoUI::Platform::Units::gridUnitChanged, this, &QmlComponentsPool::gridUnitChanged);
-    connect(m_units, &LingmoUI::Platform::Units::longDurationChanged, this, &QmlComponentsPool::longDurationChanged);
+    if (m_rects.isEmpty()) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new QSGNode;
+    }
+
+    // Reuse the rectangle nodes from the previous frame, only adding or dropping the difference
+    while (node->childCount() < m_rects.count()) {
+        node->appendChildNode(window()->createRectangleNode());
+    }
+    while (node->childCount() > m_rects.count()) {
+        QSGNode *child = node->lastChild();
+        node->removeChildNode(child);
+        delete child;
+    }
+
+    int i = 0;
+    for (QSGNode *child = node->firstChild(); child; child = child->nextSibling()) {
+        auto rectangleNode = static_cast<QSGRectangleNode *>(child);
+        const QRectF &rect = m_rects.at(i++);
+        if (rectangleNode->rect() != rect) {
+            rectangleNode->setRect(rect);
+        }
+        if (rectangleNode->color() != m_color) {
+            rectangleNode->setColor(m_color);
+        }
+    }
+
+    return node;
 }
 
-QmlComponentsPool::~QmlComponentsPool()
+/////////
+
+ColumnViewStatistics::ColumnViewStatistics(QObject *parent)
+    : LayoutStatistics(OperationCount, parent)
+{
+}
+
+ColumnViewStatistics::~ColumnViewStatistics()
+{
+}
+
+int ColumnViewStatistics::layoutCount() const
+{
+    return count(Layout);
+}
+
+qreal ColumnViewStatistics::layoutTime() const
+{
+    return time(Layout);
+}
+
+int ColumnViewStatistics::pinnedLayoutCount() const
+{
+    return count(PinnedLayout);
+}
+
+qreal ColumnViewStatistics::pinnedLayoutTime() const
+{
+    return time(PinnedLayout);
+}
+
+int ColumnViewStatistics::visibleItemsCount() const
+{
+    return count(VisibleItems);
+}
+
+qreal ColumnViewStatistics::visibleItemsTime() const
+{
+    return time(VisibleItems);
+}
+
+int ColumnViewStatistics::separatorsCount() const
+{
+    return count(Separators);
+}
+
+qreal ColumnViewStatistics::separatorsTime() const
 {
+    return time(Separators);
 }
 
 /////////
@@ -372,6 +488,9 @@ ContentItem::ContentItem(ColumnView *parent)
 {
     m_globalHeaderParent = new QQuickItem(this);
     m_globalFooterParent = new QQuickItem(this);
+    m_separators = new ColumnSeparators(this);
+    // Above the pinned columns and their headers
+    m_separators->setZ(3);
 
     setFlags(flags() | ItemIsFocusScope);
     m_slideAnim = new QPropertyAnimation(this);
@@ -380,13 +499,14 @@ ContentItem::ContentItem(ColumnView *parent)
     // NOTE: the duration will be taken from lingmoui units upon classBegin
     m_slideAnim->setDuration(0);
     m_slideAnim->setEasingCurve(QEasingCurve(QEasingCurve::OutExpo));
-    connect(m_slideAnim, &QPropertyAnimation::finished, this, [this]() {
+    connect(m_slideAnim, &QPropertyAnimation::finished, this, &ContentItem::slideFinished);
+    connect(this, &ContentItem::slideFinished, this, [this]() {
         if (!m_view->currentItem()) {
-            m_view->setCurrentIndex(m_items.indexOf(m_viewAnchorItem));
+            m_view->setCurrentIndex(indexOf(m_viewAnchorItem));
         } else {
             QRectF mapped = m_view->currentItem()->mapRectToItem(m_view, QRectF(QPointF(0, 0), m_view->currentItem()->size()));
             if (!QRectF(QPointF(0, 0), m_view->size()).intersects(mapped)) {
-                m_view->setCurrentIndex(m_items.indexOf(m_viewAnchorItem));
+                m_view->setCurrentIndex(indexOf(m_viewAnchorItem));
             }
         }
     });
@@ -404,7 +524,7 @@ void ContentItem::setBoundedX(qreal x)
     if (!parentItem()) {
         return;
     }
-    m_slideAnim->stop();
+    stopSlide();
     setX(qRound(qBound(qMin(0.0, -width() + parentItem()->width()), x, 0.0)));
 }
 
@@ -416,12 +536,74 @@ void ContentItem::animateX(qreal newX)
 
     const qreal to = qRound(qBound(qMin(0.0, -width() + parentItem()->width()), newX, 0.0));
 
-    m_slideAnim->stop();
+    stopSlide();
+
+    // Pinned columns are moved on the GUI thread at every step of the scroll, so they need the property animation
+    QQmlEngine *engine = qmlEngine(m_view);
+    if (m_view->threadedScrollAnimation() && m_pinnedColumns.isEmpty() && engine && window()) {
+        if (!m_slideAnimator) {
+            m_slideAnimator = QmlComponentsPoolSingleton::instance(engine)->slideAnimatorComponent()->create(qmlContext(m_view));
+            if (m_slideAnimator) {
+                m_slideAnimator->setParent(this);
+                m_slideAnimator->setProperty("target", QVariant::fromValue<QQuickItem *>(this));
+                connect(m_slideAnimator, SIGNAL(finished()), this, SLOT(slideAnimatorFinished()));
+            }
+        }
+    }
+
+    if (m_slideAnimator && m_view->threadedScrollAnimation() && m_pinnedColumns.isEmpty() && window()) {
+        // contentX won't change until the end, show in advance the columns the view is going to slide over
+        const int count = m_items.count();
+        if (m_view->virtualizeColumns() && m_firstDirtyColumn >= count && m_layoutPrefix.count() == count + 1) {
+            const qreal distance = m_view->virtualizationDistance();
+            updateDetachedItems(std::min(-x(), -to) - distance, std::max(-x(), -to) + m_view->width() + distance);
+        }
+
+        m_slideAnimatorTarget = to;
+        m_slideAnimatorRunning = true;
+        m_slideAnimator->setProperty("from", x());
+        m_slideAnimator->setProperty("to", to);
+        m_slideAnimator->setProperty("duration", m_slideAnim->duration());
+        QMetaObject::invokeMethod(m_slideAnimator, "start");
+        return;
+    }
+
     m_slideAnim->setStartValue(x());
     m_slideAnim->setEndValue(to);
     m_slideAnim->start();
 }
 
+void ContentItem::stopSlide()
+{
+    m_slideAnim->stop();
+
+    if (m_slideAnimatorRunning) {
+        // Like QPropertyAnimation::stop(), an interrupted slide doesn't count as finished
+        m_slideAnimatorRunning = false;
+        QMetaObject::invokeMethod(m_slideAnimator, "stop");
+    }
+}
+
+bool ContentItem::isSliding() const
+{
+    return m_slideAnimatorRunning || m_slideAnim->state() == QAbstractAnimation::Running;
+}
+
+qreal ContentItem::slideTarget() const
+{
+    return m_slideAnimatorRunning ? m_slideAnimatorTarget : m_slideAnim->endValue().toReal();
+}
+
+void ContentItem::slideAnimatorFinished()
+{
+    if (!m_slideAnimatorRunning) {
+        return;
+    }
+
+    m_slideAnimatorRunning = false;
+    Q_EMIT slideFinished();
+}
+
 void ContentItem::snapToItem()
 {
     QQuickItem *firstItem = childAt(viewportLeft(), height() / 2);
@@ -462,19 +644,17 @@ qreal ContentItem::viewportRight() const
     return -x() + m_view->width() - m_rightPinnedSpace;
 }
 
-qreal ContentItem::childWidth(QQuickItem *child)
+qreal ContentItem::childWidth(int index)
 {
     if (!parentItem()) {
         return 0.0;
     }
 
-    ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(child, true));
-
     if (m_columnResizeMode == ColumnView::SingleColumn) {
         return qRound(parentItem()->width());
 
-    } else if (attached->fillWidth()) {
-        return qRound(qBound(m_columnWidth, (parentItem()->width() - attached->reservedSpace()), std::max(m_columnWidth, parentItem()->width())));
+    } else if (m_columnFillWidth.at(index)) {
+        return qRound(qBound(m_columnWidth, (parentItem()->width() - m_columnReservedSpace.at(index)), std::max(m_columnWidth, parentItem()->width())));
 
     } else if (m_columnResizeMode == ColumnView::FixedColumns) {
         return qRound(qMin(parentItem()->width(), m_columnWidth));
@@ -482,7 +662,7 @@ qreal ContentItem::childWidth(QQuickItem *child)
         // DynamicColumns
     } else {
         // TODO:look for Layout size hints
-        qreal width = child->implicitWidth();
+        qreal width = m_items.at(index)->implicitWidth();
 
         if (width < 1.0) {
             width = m_columnWidth;
@@ -492,40 +672,64 @@ qreal ContentItem::childWidth(QQuickItem *child)
     }
 }
 
+void ContentItem::invalidateLayout(int fromIndex)
+{
+    m_firstDirtyColumn = std::min(m_firstDirtyColumn, std::max(0, fromIndex));
+}
+
 void ContentItem::layoutItems()
 {
+    ColumnViewTimer timer(m_statistics, ColumnViewStatistics::Layout, "layoutItems", m_items.count());
+
+    const qreal oldHeight = height();
     setY(m_view->topPadding());
     setHeight(m_view->height() - m_view->topPadding() - m_view->bottomPadding());
 
-    qreal implicitWidth = 0;
-    qreal implicitHeight = 0;
-    qreal partialWidth = 0;
-    int i = 0;
+    const bool reverse = qApp->layoutDirection() == Qt::RightToLeft;
+    const int count = m_items.count();
+
+    // Columns before the first invalidated one keep their size and position, so resume the pass from there.
+    // Pinned columns follow contentX and right to left layouts grow from the end of the list: both need a full pass.
+    const int firstPinnedColumn = m_pinnedColumns.isEmpty() ? count : m_pinnedColumns.first();
+    int start = std::min({m_firstDirtyColumn, firstPinnedColumn, int(m_layoutPrefix.count()) - 1, count});
+    if (reverse || m_layoutReversed || start < 0 || !qFuzzyCompare(oldHeight, height())) {
+        start = 0;
+    }
+
+    m_layoutPrefix.resize(count + 1);
+    const LayoutPrefix prefix = m_layoutPrefix.at(start);
+
+    qreal implicitWidth = prefix.implicitWidth;
+    qreal implicitHeight = prefix.implicitHeight;
+    qreal partialWidth = prefix.x;
+    int i = prefix.index;
     m_leftPinnedSpace = 0;
     m_rightPinnedSpace = 0;
+    m_pinnedColumns.clear();
 
-    bool reverse = qApp->layoutDirection() == Qt::RightToLeft;
-    auto it = !reverse ? m_items.begin() : m_items.end();
-    int increment = reverse ? -1 : +1;
-    auto lastPos = reverse ? m_items.begin() : m_items.end();
+    for (int pos = start; pos < count; ++pos) {
+        m_layoutPrefix[pos] = {partialWidth, implicitWidth, implicitHeight, i};
 
-    for (; it != lastPos; it += increment) {
-        // for (QQuickItem *child : std::as_const(m_items)) {
-        QQuickItem *child = reverse ? *(it - 1) : *it;
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(child, true));
+        const int index = reverse ? count - 1 - pos : pos;
+        QQuickItem *child = m_items.at(index);
+        ColumnViewAttached *attached = m_columnAttached.at(index);
         if (child == m_globalHeaderParent || child == m_globalFooterParent) {
             continue;
         }
 
+        // Update the index first, as it may change whether the column fills the view
+        if (reverse) {
+            attached->setIndex(m_items.count() - (++i));
+        } else {
+            attached->setIndex(i++);
+        }
+
+        // Columns culled by virtualization stay visible, so they keep their place
         if (child->isVisible()) {
-            if (attached->isPinned() && m_view->columnResizeMode() != ColumnView::SingleColumn) {
-                QQuickItem *sep = nullptr;
-                int sepWidth = 0;
-                if (m_view->separatorVisible()) {
-                    sep = ensureTrailingSeparator(child);
-                    sepWidth = (sep ? sep->width() : 0);
-                }
-                const qreal width = childWidth(child);
+            if (m_columnPinned.at(index) && m_view->columnResizeMode() != ColumnView::SingleColumn) {
+                m_pinnedColumns << pos;
+                const qreal sepWidth = m_view->separatorVisible() ? ColumnSeparators::separatorWidth : 0;
+                const qreal width = childWidth(index);
                 const qreal widthDiff = std::max(0.0, m_view->width() - child->width()); // it's possible for the view width to be smaller than the child width
                 const qreal pageX = std::clamp(partialWidth, -x(), -x() + widthDiff);
                 qreal headerHeight = .0;
@@ -535,20 +739,12 @@ void ContentItem::layoutItems()
                     header->setWidth(width + sepWidth);
                     header->setPosition(QPointF(pageX, .0));
                     header->setZ(2);
-                    if (m_view->separatorVisible()) {
-                        QQuickItem *sep = ensureTrailingSeparator(header);
-                        sep->setProperty("inToolBar", true);
-                    }
                 }
                 if (QQuickItem *footer = attached->globalFooter()) {
                     footerHeight = footer->isVisible() ? footer->height() : .0;
                     footer->setWidth(width + sepWidth);
                     footer->setPosition(QPointF(pageX, height() - footerHeight));
                     footer->setZ(2);
-                    if (m_view->separatorVisible()) {
-                        QQuickItem *sep = ensureTrailingSeparator(footer);
-                        sep->setProperty("inToolBar", true);
-                    }
                 }
 
                 child->setSize(QSizeF(width + sepWidth, height() - headerHeight - footerHeight));
@@ -564,47 +760,23 @@ void ContentItem::layoutItems()
                 partialWidth += width;
 
             } else {
-                const qreal width = childWidth(child);
+                const qreal width = childWidth(index);
                 qreal headerHeight = .0;
                 qreal footerHeight = .0;
                 if (QQuickItem *header = attached->globalHeader(); header && qmlEngine(header)) {
-                    if (m_view->separatorVisible()) {
-                        QQuickItem *sep = ensureLeadingSeparator(header);
-                        sep->setProperty("inToolBar", true);
-                    }
                     headerHeight = header->isVisible() ? header->height() : .0;
                     header->setWidth(width);
                     header->setPosition(QPointF(partialWidth, .0));
                     header->setZ(1);
-                    auto it = m_trailingSeparators.find(header);
-                    if (it != m_trailingSeparators.end()) {
-                        it.value()->deleteLater();
-                        m_trailingSeparators.erase(it);
-                    }
                 }
                 if (QQuickItem *footer = attached->globalFooter(); footer && qmlEngine(footer)) {
-                    if (m_view->separatorVisible()) {
-                        QQuickItem *sep = ensureLeadingSeparator(footer);
-                        sep->setProperty("inToolBar", true);
-                    }
                     footerHeight = footer->isVisible() ? footer->height() : .0;
                     footer->setWidth(width);
                     footer->setPosition(QPointF(partialWidth, height() - footerHeight));
                     footer->setZ(1);
-                    auto it = m_trailingSeparators.find(footer);
-                    if (it != m_trailingSeparators.end()) {
-                        it.value()->deleteLater();
-                        m_trailingSeparators.erase(it);
-                    }
                 }
 
                 child->setSize(QSizeF(width, height() - headerHeight - footerHeight));
-
-                auto it = m_trailingSeparators.find(child);
-                if (it != m_trailingSeparators.end()) {
-                    it.value()->deleteLater();
-                    m_trailingSeparators.erase(it);
-                }
                 child->setPosition(QPointF(partialWidth, headerHeight));
                 child->setZ(0);
 
@@ -612,17 +784,15 @@ void ContentItem::layoutItems()
             }
         }
 
-        if (reverse) {
-            attached->setIndex(m_items.count() - (++i));
-        } else {
-            attached->setIndex(i++);
-        }
-
         implicitWidth += child->implicitWidth();
 
         implicitHeight = qMax(implicitHeight, child->implicitHeight());
     }
 
+    m_layoutPrefix[count] = {partialWidth, implicitWidth, implicitHeight, i};
+    m_firstDirtyColumn = std::numeric_limits<int>::max();
+    m_layoutReversed = reverse;
+
     setWidth(partialWidth);
 
     setImplicitWidth(implicitWidth);
@@ -647,77 +817,226 @@ void ContentItem::layoutPinnedItems()
         return;
     }
 
-    qreal partialWidth = 0;
+    const int count = m_items.count();
+    // Nothing to do until the next layout pass recorded where the pinned columns are
+    if (m_layoutPrefix.count() != count + 1) {
+        return;
+    }
+
+    ColumnViewTimer timer(m_statistics, ColumnViewStatistics::PinnedLayout, "layoutPinnedItems", count);
+
     m_leftPinnedSpace = 0;
     m_rightPinnedSpace = 0;
 
-    for (QQuickItem *child : std::as_const(m_items)) {
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(child, true));
+    // Only pinned columns follow contentX, every other column stays where layoutItems() put it
+    for (int pos : std::as_const(m_pinnedColumns)) {
+        const int index = m_layoutReversed ? count - 1 - pos : pos;
+        QQuickItem *child = m_items.at(index);
+        if (!child->isVisible()) {
+            continue;
+        }
+        ColumnViewAttached *attached = m_columnAttached.at(index);
 
-        if (child->isVisible()) {
-            if (attached->isPinned()) {
-                QQuickItem *sep = nullptr;
-                int sepWidth = 0;
-                if (m_view->separatorVisible()) {
-                    sep = ensureTrailingSeparator(child);
-                    sepWidth = (sep ? sep->width() : 0);
-                }
+        const qreal partialWidth = m_layoutPrefix.at(pos).x;
+        const qreal sepWidth = m_view->separatorVisible() ? ColumnSeparators::separatorWidth : 0;
 
-                const qreal pageX = qMin(qMax(-x(), partialWidth), -x() + m_view->width() - child->width() + sepWidth);
-                qreal headerHeight = .0;
-                qreal footerHeight = .0;
-                if (QQuickItem *header = attached->globalHeader()) {
-                    headerHeight = header->isVisible() ? header->height() : .0;
-                    header->setPosition(QPointF(pageX, .0));
-                    if (m_view->separatorVisible()) {
-                        QQuickItem *sep = ensureTrailingSeparator(header);
-                        sep->setProperty("inToolBar", true);
-                    }
-                }
-                if (QQuickItem *footer = attached->globalFooter()) {
-                    footerHeight = footer->isVisible() ? footer->height() : .0;
-                    footer->setPosition(QPointF(pageX, height() - footerHeight));
-                    if (m_view->separatorVisible()) {
-                        QQuickItem *sep = ensureTrailingSeparator(footer);
-                        sep->setProperty("inToolBar", true);
-                    }
-                }
-                child->setPosition(QPointF(pageX, headerHeight));
+        const qreal pageX = qMin(qMax(-x(), partialWidth), -x() + m_view->width() - child->width() + sepWidth);
+        qreal headerHeight = .0;
+        qreal footerHeight = .0;
+        if (QQuickItem *header = attached->globalHeader()) {
+            headerHeight = header->isVisible() ? header->height() : .0;
+            header->setPosition(QPointF(pageX, .0));
+        }
+        if (QQuickItem *footer = attached->globalFooter()) {
+            footerHeight = footer->isVisible() ? footer->height() : .0;
+            footer->setPosition(QPointF(pageX, height() - footerHeight));
+        }
+        child->setPosition(QPointF(pageX, headerHeight));
 
-                if (partialWidth <= -x()) {
-                    m_leftPinnedSpace = qMax(m_leftPinnedSpace, child->width() - sepWidth);
-                } else if (partialWidth > -x() + m_view->width() - child->width() + sepWidth) {
-                    m_rightPinnedSpace = qMax(m_rightPinnedSpace, child->width());
-                }
-            }
+        if (partialWidth <= -x()) {
+            m_leftPinnedSpace = qMax(m_leftPinnedSpace, child->width() - sepWidth);
+        } else if (partialWidth > -x() + m_view->width() - child->width() + sepWidth) {
+            m_rightPinnedSpace = qMax(m_rightPinnedSpace, child->width());
+        }
+    }
 
-            partialWidth += child->width();
+    if (!m_pinnedColumns.isEmpty()) {
+        updateSeparators();
+    }
+}
+
+bool ContentItem::isInViewport(QQuickItem *item) const
+{
+    if (item == m_globalHeaderParent || item == m_globalFooterParent) {
+        return false;
+    }
+    return item->isVisible() && !m_detachedItems.contains(item) && item->x() + x() < m_view->width() && item->x() + item->width() + x() > 0;
+}
+
+std::pair<int, int> ContentItem::columnRange(qreal left, qreal right) const
+{
+    // Columns are laid out one after the other, so the ones overlapping [left, right] are a contiguous range
+    const auto firstIt = std::upper_bound(m_layoutPrefix.cbegin() + 1, m_layoutPrefix.cend(), left, [](qreal value, const LayoutPrefix &prefix) {
+        return value < prefix.x;
+    });
+    const auto lastIt = std::lower_bound(m_layoutPrefix.cbegin(), m_layoutPrefix.cend() - 1, right, [](const LayoutPrefix &prefix, qreal value) {
+        return prefix.x < value;
+    });
+    return {int(firstIt - m_layoutPrefix.cbegin()) - 1, int(lastIt - m_layoutPrefix.cbegin())};
+}
+
+void ContentItem::setDetached(QQuickItem *item, bool detached)
+{
+    // Culling only takes the column out of rendering, its visibility stays up to the user
+    QQuickItemPrivate::get(item)->setCulled(detached);
+
+    if (detached) {
+        m_detachedItems.insert(item);
+    } else {
+        m_detachedItems.remove(item);
+    }
+}
+
+void ContentItem::updateDetachedItems(qreal left, qreal right)
+{
+    const int count = m_items.count();
+    const auto [first, last] = columnRange(left, right);
+
+    QList<QQuickItem *> attachedItems;
+    attachedItems.reserve(last - first);
+    for (int pos = first; pos < last; ++pos) {
+        QQuickItem *item = m_layoutReversed ? m_items.at(count - 1 - pos) : m_items.at(pos);
+        attachedItems << item;
+        if (m_detachedItems.contains(item)) {
+            setDetached(item, false);
+        }
+    }
+
+    // Only the columns that just left the range, or were never placed, can need hiding
+    const auto maybeDetach = [this, &attachedItems](QQuickItem *item) {
+        if (attachedItems.contains(item) || !item->isVisible() || item == m_view->currentItem()) {
+            return;
+        }
+        // Leave alone columns that have been removed from the view meanwhile
+        const int index = indexOf(item);
+        if (index < 0 || m_columnPinned.at(index)) {
+            return;
         }
+        setDetached(item, true);
+    };
+    for (QQuickItem *item : std::as_const(m_attachedItems)) {
+        maybeDetach(item);
+    }
+    for (QQuickItem *item : std::as_const(m_unplacedItems)) {
+        maybeDetach(item);
+    }
+
+    m_attachedItems = attachedItems;
+}
+
+void ContentItem::resetDetachedItems()
+{
+    const auto detachedItems = m_detachedItems;
+    for (QQuickItem *item : detachedItems) {
+        setDetached(item, false);
     }
+    m_attachedItems.clear();
+    // Let the next update decide again for every column
+    m_unplacedItems = m_items;
 }
 
 void ContentItem::updateVisibleItems()
 {
+    ColumnViewTimer timer(m_statistics, ColumnViewStatistics::VisibleItems, "updateVisibleItems", m_items.count());
+
     QList<QObject *> newItems;
+    const int count = m_items.count();
 
-    for (auto *item : std::as_const(m_items)) {
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+    if (m_firstDirtyColumn < count || m_layoutPrefix.count() != count + 1) {
+        // A relayout is pending and the cached offsets are stale, check every column
+        for (auto *item : std::as_const(m_items)) {
+            if (isInViewport(item)) {
+                newItems << item;
+            }
+        }
+    } else {
+        const qreal left = -x();
+        const qreal right = -x() + m_view->width();
+        if (m_view->virtualizeColumns()) {
+            updateDetachedItems(left - m_view->virtualizationDistance(), right + m_view->virtualizationDistance());
+        }
 
-        if (item->isVisible() && item->x() + x() < m_view->width() && item->x() + item->width() + x() > 0) {
-            newItems << item;
-            connect(item, &QObject::destroyed, this, [this, item] {
-                m_visibleItems.removeAll(item);
-            });
-            attached->setInViewport(true);
-            item->setEnabled(true);
-        } else {
-            attached->setInViewport(false);
-            item->setEnabled(false);
+        // Apart from the pinned ones, the visible columns are the range overlapping the viewport
+        const auto [first, last] = columnRange(left, right);
+
+        QVarLengthArray<int, 8> positions;
+        for (int pos = first; pos < last; ++pos) {
+            positions << pos;
+        }
+        for (int pos : std::as_const(m_pinnedColumns)) {
+            if (pos < first || pos >= last) {
+                positions << pos;
+            }
+        }
+        std::sort(positions.begin(), positions.end());
+
+        // m_visibleItems follows the order of m_items, which is the reverse of the layout order in right to left mode
+        const auto itemAt = [this, count](int pos) {
+            return m_layoutReversed ? m_items.at(count - 1 - pos) : m_items.at(pos);
+        };
+        for (int pos : std::as_const(positions)) {
+            QQuickItem *item = itemAt(pos);
+            if (isInViewport(item)) {
+                newItems << item;
+            }
+        }
+        if (m_layoutReversed) {
+            std::reverse(newItems.begin(), newItems.end());
         }
     }
 
-    for (auto *item : std::as_const(m_visibleItems)) {
-        disconnect(item, &QObject::destroyed, this, nullptr);
+    // Columns are checked against their actual geometry when a layout pass is pending,
+    // decide for the newly added ones once they have been laid out
+    const bool placeNewItems = m_firstDirtyColumn >= count && m_layoutPrefix.count() == count + 1;
+
+    const auto setInViewport = [this](QObject *object, bool inViewport) {
+        auto item = static_cast<QQuickItem *>(object);
+        // Leave alone columns that have been removed from the view meanwhile
+        const int index = indexOf(item);
+        if (index < 0) {
+            return;
+        }
+        m_columnAttached.at(index)->setInViewport(inViewport);
+        item->setEnabled(inViewport);
+    };
+
+    // Only touch the columns entering or leaving the viewport
+    for (QObject *item : std::as_const(m_visibleItems)) {
+        if (!newItems.contains(item)) {
+            setInViewport(item, false);
+        }
+    }
+    for (QObject *item : std::as_const(newItems)) {
+        if (!m_visibleItems.contains(item)) {
+            setInViewport(item, true);
+        }
+    }
+    if (placeNewItems) {
+        for (QQuickItem *item : std::as_const(m_unplacedItems)) {
+            if (!newItems.contains(item)) {
+                setInViewport(item, false);
+            }
+        }
+        m_unplacedItems.clear();
+
+        // Placeholders are only known to be on screen once laid out
+        for (QObject *object : std::as_const(newItems)) {
+            auto item = static_cast<QQuickItem *>(object);
+            if (m_deferredItems.contains(item) && !m_pendingDeferredItems.contains(item)) {
+                m_pendingDeferredItems << item;
+                m_view->polish();
+            }
+        }
     }
 
     const QQuickItem *oldLeadingVisibleItem = m_view->leadingVisibleItem();
@@ -733,11 +1052,14 @@ void ContentItem::updateVisibleItems()
             Q_EMIT m_view->trailingVisibleItemChanged();
         }
     }
+
+    updateSeparators();
 }
 
 void ContentItem::forgetItem(QQuickItem *item)
 {
-    if (!m_items.contains(item)) {
+    const int index = indexOf(item);
+    if (index < 0) {
         return;
     }
 
@@ -749,42 +1071,24 @@ void ContentItem::forgetItem(QQuickItem *item)
     disconnect(item, nullptr, this, nullptr);
     disconnect(item, nullptr, m_view, nullptr);
 
-    QQuickItem *separatorItem = m_leadingSeparators.take(item);
-    if (separatorItem) {
-        separatorItem->deleteLater();
-    }
-    separatorItem = m_trailingSeparators.take(item);
-    if (separatorItem) {
-        separatorItem->deleteLater();
-    }
-
     if (QQuickItem *header = attached->globalHeader()) {
         header->setVisible(false);
         header->setParentItem(item);
-        separatorItem = m_leadingSeparators.take(header);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
-        separatorItem = m_trailingSeparators.take(header);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
     }
     if (QQuickItem *footer = attached->globalFooter()) {
         footer->setVisible(false);
         footer->setParentItem(item);
-        separatorItem = m_leadingSeparators.take(footer);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
-        separatorItem = m_trailingSeparators.take(footer);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
     }
 
-    const int index = m_items.indexOf(item);
-    m_items.removeAll(item);
+    removeItemAt(index);
+    m_deferredItems.remove(item);
+    m_pendingDeferredItems.removeAll(item);
+    m_unplacedItems.removeAll(item);
+    m_attachedItems.removeAll(item);
+    if (m_detachedItems.contains(item)) {
+        setDetached(item, false);
+    }
+    invalidateLayout(index);
     // We are connected not only to destroyed but also to lambdas
     disconnect(item, nullptr, this, nullptr);
     updateVisibleItems();
@@ -797,45 +1101,181 @@ void ContentItem::forgetItem(QQuickItem *item)
     Q_EMIT m_view->countChanged();
 }
 
-QQuickItem *ContentItem::ensureLeadingSeparator(QQuickItem *item)
+void ContentItem::updateSeparators()
 {
-    QQuickItem *separatorItem = m_leadingSeparators.value(item);
+    ColumnViewTimer timer(m_statistics, ColumnViewStatistics::Separators, "updateSeparators", m_items.count());
+
+    QList<QRectF> rects;
+    if (!m_view->separatorVisible()) {
+        m_separators->setSeparators(rects);
+        return;
+    }
+
+    const bool reverse = qApp->layoutDirection() == Qt::RightToLeft;
+    const bool singleColumn = m_view->columnResizeMode() == ColumnView::SingleColumn;
+    const qreal separatorWidth = ColumnSeparators::separatorWidth;
+    QQmlEngine *engine = qmlEngine(m_view);
+    const qreal toolBarMargin = engine ? QmlComponentsPoolSingleton::instance(engine)->m_units->largeSpacing() : 0;
 
-    if (!separatorItem) {
-        separatorItem = qobject_cast<QQuickItem *>(
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_leadingSeparatorComponent->beginCreate(QQmlEngine::contextForObject(item)));
-        if (separatorItem) {
-            separatorItem->setParent(this);
-            separatorItem->setParentItem(item);
-            separatorItem->setZ(9999);
-            separatorItem->setProperty("column", QVariant::fromValue(item));
-            separatorItem->setProperty("view", QVariant::fromValue(m_view));
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_leadingSeparatorComponent->completeCreate();
-            m_leadingSeparators[item] = separatorItem;
+    // Pinned columns are stacked above the others and hide their separators
+    QVarLengthArray<std::pair<QQuickItem *, QRectF>, 4> pinnedRects;
+    for (QObject *object : std::as_const(m_visibleItems)) {
+        auto column = static_cast<QQuickItem *>(object);
+        const int index = indexOf(column);
+        if (!singleColumn && index >= 0 && m_columnPinned.at(index)) {
+            pinnedRects.append({column, column->mapRectToItem(m_separators, column->boundingRect())});
         }
     }
+    const auto addSeparator = [&](QQuickItem *column, const QRectF &rect) {
+        for (const auto &[pinnedColumn, pinnedRect] : std::as_const(pinnedRects)) {
+            if (pinnedColumn != column && rect.left() >= pinnedRect.left() && rect.left() < pinnedRect.right()) {
+                return;
+            }
+        }
+        rects << rect;
+    };
+    const auto addLeading = [&](QQuickItem *column, QQuickItem *item, qreal margin) {
+        const QRectF rect = item->mapRectToItem(m_separators, item->boundingRect());
+        // The separator of the very first column, touching the edge of the view, is hidden
+        const bool visible = reverse ? -x() + m_view->width() > rect.right() : -x() < rect.left();
+        if (visible) {
+            addSeparator(column, QRectF(reverse ? rect.right() - separatorWidth : rect.left(), rect.top() + margin, separatorWidth, rect.height() - margin * 2));
+        }
+    };
+    const auto addTrailing = [&](QQuickItem *column, QQuickItem *item) {
+        const QRectF rect = item->mapRectToItem(m_separators, item->boundingRect());
+        addSeparator(column, QRectF(reverse ? rect.left() : rect.right() - separatorWidth, rect.top(), separatorWidth, rect.height()));
+    };
 
-    return separatorItem;
+    // Only the columns on screen need their separators
+    for (QObject *object : std::as_const(m_visibleItems)) {
+        auto column = static_cast<QQuickItem *>(object);
+        const int index = indexOf(column);
+        if (index < 0) {
+            continue;
+        }
+        const ColumnViewAttached *attached = m_columnAttached.at(index);
+        addLeading(column, column, 0);
+
+        QQuickItem *header = attached->globalHeader();
+        QQuickItem *footer = attached->globalFooter();
+        if (!singleColumn && m_columnPinned.at(index)) {
+            addTrailing(column, column);
+            if (header && header->isVisible()) {
+                addTrailing(column, header);
+            }
+            if (footer && footer->isVisible()) {
+                addTrailing(column, footer);
+            }
+        } else {
+            if (header && header->isVisible() && qmlEngine(header)) {
+                addLeading(column, header, toolBarMargin);
+            }
+            if (footer && footer->isVisible() && qmlEngine(footer)) {
+                addLeading(column, footer, toolBarMargin);
+            }
+        }
+    }
+
+    m_separators->setSeparators(rects);
 }
 
-QQuickItem *ContentItem::ensureTrailingSeparator(QQuickItem *item)
+int ContentItem::indexOf(QQuickItem *item) const
 {
-    QQuickItem *separatorItem = m_trailingSeparators.value(item);
+    auto it = m_itemIndices.constFind(item);
+    if (it == m_itemIndices.cend()) {
+        return -1;
+    }
 
-    if (!separatorItem) {
-        separatorItem = qobject_cast<QQuickItem *>(
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_trailingSeparatorComponent->beginCreate(QQmlEngine::contextForObject(item)));
-        if (separatorItem) {
-            separatorItem->setParent(this);
-            separatorItem->setParentItem(item);
-            separatorItem->setZ(9999);
-            separatorItem->setProperty("column", QVariant::fromValue(item));
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_trailingSeparatorComponent->completeCreate();
-            m_trailingSeparators[item] = separatorItem;
+    if (*it >= m_validItemIndices) {
+        for (int i = m_validItemIndices; i < m_items.count(); ++i) {
+            m_itemIndices[m_items.at(i)] = i;
         }
+        m_validItemIndices = m_items.count();
+        it = m_itemIndices.constFind(item);
+    }
+
+    return *it;
+}
+
+void ContentItem::insertItemAt(int pos, QQuickItem *item)
+{
+    auto attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+
+    m_items.insert(pos, item);
+    m_itemIndices[item] = pos;
+    m_validItemIndices = std::min(m_validItemIndices, pos);
+
+    m_columnAttached.insert(pos, attached);
+    m_columnReservedSpace.insert(pos, attached->reservedSpace());
+    m_columnFillWidth.insert(pos, attached->fillWidth());
+    m_columnPinned.insert(pos, attached->isPinned());
+}
+
+void ContentItem::moveItem(int from, int to)
+{
+    m_items.move(from, to);
+    m_validItemIndices = std::min({m_validItemIndices, from, to});
+
+    m_columnAttached.move(from, to);
+    m_columnReservedSpace.move(from, to);
+    m_columnFillWidth.move(from, to);
+    m_columnPinned.move(from, to);
+}
+
+void ContentItem::removeItemAt(int pos)
+{
+    m_itemIndices.remove(m_items.takeAt(pos));
+    m_validItemIndices = std::min(m_validItemIndices, pos);
+
+    m_columnAttached.removeAt(pos);
+    m_columnReservedSpace.removeAt(pos);
+    m_columnFillWidth.removeAt(pos);
+    m_columnPinned.removeAt(pos);
+}
+
+void ContentItem::replaceItemAt(int pos, QQuickItem *item)
+{
+    m_itemIndices.remove(m_items.at(pos));
+    m_items[pos] = item;
+    m_itemIndices[item] = pos;
+
+    m_columnAttached[pos] = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+    updateColumnData(item);
+}
+
+void ContentItem::setItems(const QList<QQuickItem *> &items)
+{
+    m_items = items;
+    m_itemIndices.clear();
+    m_itemIndices.reserve(m_items.count());
+    m_columnAttached.clear();
+    m_columnAttached.reserve(m_items.count());
+    for (int i = 0; i < m_items.count(); ++i) {
+        m_itemIndices.insert(m_items.at(i), i);
+        m_columnAttached << qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(m_items.at(i), true));
     }
+    m_validItemIndices = m_items.count();
 
-    return separatorItem;
+    m_columnReservedSpace.resize(m_items.count());
+    m_columnFillWidth.resize(m_items.count());
+    m_columnPinned.resize(m_items.count());
+    for (QQuickItem *item : items) {
+        updateColumnData(item);
+    }
+}
+
+void ContentItem::updateColumnData(QQuickItem *item)
+{
+    const int index = indexOf(item);
+    if (index < 0) {
+        return;
+    }
+
+    const ColumnViewAttached *attached = m_columnAttached.at(index);
+    m_columnReservedSpace[index] = attached->reservedSpace();
+    m_columnFillWidth[index] = attached->fillWidth();
+    m_columnPinned[index] = attached->isPinned();
 }
 
 void ContentItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
@@ -849,26 +1289,39 @@ void ContentItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::It
         ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(value.item, true));
         attached->setView(m_view);
 
-        // connect(attached, &ColumnViewAttached::fillWidthChanged, m_view, &ColumnView::polish);
-        connect(attached, &ColumnViewAttached::fillWidthChanged, this, [this] {
+        // A column changing its own size only moves the columns after it
+        const auto invalidateFromColumn = [this, attached] {
+            invalidateLayout(attached->index());
             m_view->polish();
+        };
+        const auto columnDataChanged = [this, item = value.item, invalidateFromColumn] {
+            updateColumnData(item);
+            invalidateFromColumn();
+        };
+        connect(attached, &ColumnViewAttached::fillWidthChanged, this, columnDataChanged);
+        connect(attached, &ColumnViewAttached::reservedSpaceChanged, this, columnDataChanged);
+        connect(attached, &ColumnViewAttached::pinnedChanged, this, [this, item = value.item] {
+            updateColumnData(item);
+            invalidateLayout();
         });
-        connect(attached, &ColumnViewAttached::reservedSpaceChanged, m_view, &ColumnView::polish);
 
         value.item->setVisible(true);
 
-        if (!m_items.contains(value.item)) {
-            connect(value.item, &QQuickItem::widthChanged, m_view, &ColumnView::polish);
+        if (indexOf(value.item) < 0) {
             QQuickItem *item = value.item;
-            m_items << item;
+            insertItemAt(m_items.count(), item);
             connect(item, &QObject::destroyed, this, [this, item]() {
                 m_view->removeItem(item);
             });
         }
-
-        if (m_view->separatorVisible()) {
-            ensureLeadingSeparator(value.item);
-        }
+        // Joining the view may have changed the default fillWidth and reservedSpace
+        updateColumnData(value.item);
+        connect(value.item, &QQuickItem::widthChanged, this, invalidateFromColumn);
+        connect(value.item, &QQuickItem::visibleChanged, this, invalidateFromColumn);
+        connect(value.item, &QQuickItem::implicitWidthChanged, this, invalidateFromColumn);
+        connect(value.item, &QQuickItem::implicitHeightChanged, this, invalidateFromColumn);
+        invalidateLayout(indexOf(value.item));
+        m_unplacedItems << value.item;
 
         m_shouldAnimate = true;
         m_view->polish();
@@ -899,11 +1352,16 @@ void ContentItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeo
 
 void ContentItem::syncItemsOrder()
 {
-    if (m_items == childItems()) {
+    QList<QQuickItem *> items = childItems();
+    items.removeOne(m_globalHeaderParent);
+    items.removeOne(m_globalFooterParent);
+    items.removeOne(m_separators);
+    if (m_items == items) {
         return;
     }
 
-    m_items = childItems();
+    setItems(items);
+    invalidateLayout();
     // NOTE: polish() here sometimes gets indefinitely delayed and items changing order isn't seen
     layoutItems();
 }
@@ -944,8 +1402,12 @@ void ContentItem::connectHeader(QQuickItem *oldHeader, QQuickItem *newHeader)
         oldHeader->setParentItem(nullptr);
     }
     if (newHeader) {
-        connect(newHeader, &QQuickItem::heightChanged, this, &ContentItem::layoutItems);
-        connect(newHeader, &QQuickItem::visibleChanged, this, &ContentItem::layoutItems);
+        const auto relayout = [this] {
+            invalidateLayout();
+            layoutItems();
+        };
+        connect(newHeader, &QQuickItem::heightChanged, this, relayout);
+        connect(newHeader, &QQuickItem::visibleChanged, this, relayout);
         newHeader->setParentItem(m_globalHeaderParent);
     }
 }
@@ -957,8 +1419,12 @@ void ContentItem::connectFooter(QQuickItem *oldFooter, QQuickItem *newFooter)
         oldFooter->setParentItem(nullptr);
     }
     if (newFooter) {
-        connect(newFooter, &QQuickItem::heightChanged, this, &ContentItem::layoutItems);
-        connect(newFooter, &QQuickItem::visibleChanged, this, &ContentItem::layoutItems);
+        const auto relayout = [this] {
+            invalidateLayout();
+            layoutItems();
+        };
+        connect(newFooter, &QQuickItem::heightChanged, this, relayout);
+        connect(newFooter, &QQuickItem::visibleChanged, this, relayout);
         newFooter->setParentItem(m_globalFooterParent);
     }
 }
@@ -975,7 +1441,7 @@ ColumnView::ColumnView(QQuickItem *parent)
     setAcceptTouchEvents(false); // Relies on synthetized mouse events
     setFiltersChildMouseEvents(true);
 
-    connect(m_contentItem->m_slideAnim, &QPropertyAnimation::finished, this, [this]() {
+    connect(m_contentItem, &ContentItem::slideFinished, this, [this]() {
         m_moving = false;
         Q_EMIT movingChanged();
     });
@@ -1013,6 +1479,7 @@ void ColumnView::setColumnResizeMode(ColumnResizeMode mode)
         m_contentItem->m_viewAnchorItem = m_currentItem;
     }
     m_contentItem->m_shouldAnimate = false;
+    m_contentItem->invalidateLayout();
     polish();
     Q_EMIT columnResizeModeChanged();
 }
@@ -1033,6 +1500,7 @@ void ColumnView::setColumnWidth(qreal width)
 
     m_contentItem->m_columnWidth = width;
     m_contentItem->m_shouldAnimate = false;
+    m_contentItem->invalidateLayout();
     polish();
     Q_EMIT columnWidthChanged();
 }
@@ -1050,19 +1518,27 @@ void ColumnView::setCurrentIndex(int index)
 
     m_currentIndex = index;
 
+    // The previous current column may be hidden again once out of reach
+    if (m_virtualizeColumns && m_currentItem) {
+        m_contentItem->m_unplacedItems << m_currentItem;
+    }
+
     if (index == -1) {
         m_currentItem.clear();
 
     } else {
         m_currentItem = m_contentItem->m_items[index];
         Q_ASSERT(m_currentItem);
+        if (m_contentItem->m_detachedItems.contains(m_currentItem)) {
+            m_contentItem->setDetached(m_currentItem, false);
+        }
         m_currentItem->forceActiveFocus();
 
         // If the current item is not on view, scroll
         QRectF mappedCurrent = m_currentItem->mapRectToItem(this, QRectF(QPointF(0, 0), m_currentItem->size()));
 
-        if (m_contentItem->m_slideAnim->state() == QAbstractAnimation::Running) {
-            mappedCurrent.moveLeft(mappedCurrent.left() + m_contentItem->x() + m_contentItem->m_slideAnim->endValue().toInt());
+        if (m_contentItem->isSliding()) {
+            mappedCurrent.moveLeft(mappedCurrent.left() + m_contentItem->x() + qRound(m_contentItem->slideTarget()));
         }
 
         // m_contentItem->m_slideAnim->stop();
@@ -1135,6 +1611,7 @@ void ColumnView::setTopPadding(qreal padding)
     }
 
     m_topPadding = padding;
+    m_contentItem->invalidateLayout();
     polish();
     Q_EMIT topPaddingChanged();
 }
@@ -1151,6 +1628,7 @@ void ColumnView::setBottomPadding(qreal padding)
     }
 
     m_bottomPadding = padding;
+    m_contentItem->invalidateLayout();
     polish();
     Q_EMIT bottomPaddingChanged();
 }
@@ -1189,6 +1667,10 @@ void ColumnView::setSeparatorVisible(bool visible)
     }
 
     m_separatorVisible = visible;
+    // Pinned columns make room for their separator
+    m_contentItem->invalidateLayout();
+    polish();
+    m_contentItem->updateSeparators();
 
     Q_EMIT separatorVisibleChanged();
 }
@@ -1270,37 +1752,84 @@ void ColumnView::setAcceptsMouse(bool accepts)
     Q_EMIT acceptsMouseChanged();
 }
 
-void ColumnView::addItem(QQuickItem *item)
+bool ColumnView::threadedScrollAnimation() const
 {
-    insertItem(m_contentItem->m_items.length(), item);
+    return m_threadedScrollAnimation;
 }
 
-void ColumnView::insertItem(int pos, QQuickItem *item)
+void ColumnView::setThreadedScrollAnimation(bool threaded)
 {
-    if (!item || m_contentItem->m_items.contains(item)) {
+    if (m_threadedScrollAnimation == threaded) {
         return;
     }
 
-    m_contentItem->m_items.insert(qBound(0, pos, m_contentItem->m_items.length()), item);
+    m_threadedScrollAnimation = threaded;
+    Q_EMIT threadedScrollAnimationChanged();
+}
 
-    connect(item, &QObject::destroyed, m_contentItem, [this, item]() {
-        removeItem(item);
-    });
-    ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
-    attached->setOriginalParent(item->parentItem());
-    attached->setShouldDeleteOnRemove(item->parentItem() == nullptr && QQmlEngine::objectOwnership(item) == QQmlEngine::JavaScriptOwnership);
-    item->setParentItem(m_contentItem);
+ColumnViewStatistics *ColumnView::statistics()
+{
+    if (!m_contentItem->m_statistics) {
+        m_contentItem->m_statistics = new ColumnViewStatistics(this);
+    }
+    return m_contentItem->m_statistics;
+}
 
-    item->forceActiveFocus();
+bool ColumnView::virtualizeColumns() const
+{
+    return m_virtualizeColumns;
+}
 
-    if (attached->globalHeader()) {
-        m_contentItem->connectHeader(nullptr, attached->globalHeader());
+void ColumnView::setVirtualizeColumns(bool virtualize)
+{
+    if (m_virtualizeColumns == virtualize) {
+        return;
     }
-    if (attached->globalFooter()) {
-        m_contentItem->connectFooter(nullptr, attached->globalFooter());
+
+    m_virtualizeColumns = virtualize;
+    m_contentItem->resetDetachedItems();
+    m_contentItem->updateVisibleItems();
+
+    Q_EMIT virtualizeColumnsChanged();
+}
+
+qreal ColumnView::virtualizationDistance() const
+{
+    return m_virtualizationDistance;
+}
+
+void ColumnView::setVirtualizationDistance(qreal distance)
+{
+    distance = std::max(0.0, distance);
+    if (qFuzzyCompare(m_virtualizationDistance, distance)) {
+        return;
     }
-    connect(attached, &ColumnViewAttached::globalHeaderChanged, m_contentItem, &ContentItem::connectHeader);
-    connect(attached, &ColumnViewAttached::globalFooterChanged, m_contentItem, &ContentItem::connectFooter);
+
+    m_virtualizationDistance = distance;
+    if (m_virtualizeColumns) {
+        m_contentItem->resetDetachedItems();
+        m_contentItem->updateVisibleItems();
+    }
+
+    Q_EMIT virtualizationDistanceChanged();
+}
+
+void ColumnView::addItem(QQuickItem *item)
+{
+    insertItem(m_contentItem->m_items.length(), item);
+}
+
+void ColumnView::insertItem(int pos, QQuickItem *item)
+{
+    if (!item || m_contentItem->indexOf(item) >= 0) {
+        return;
+    }
+
+    m_contentItem->insertItemAt(qBound(0, pos, m_contentItem->m_items.length()), item);
+    m_contentItem->invalidateLayout(pos);
+    adoptItem(item);
+
+    item->forceActiveFocus();
 
     // Animate shift to new item.
     m_contentItem->m_shouldAnimate = true;
@@ -1349,25 +1878,10 @@ void ColumnView::replaceItem(int pos, QQuickItem *item)
 
     Q_EMIT itemRemoved(oldItem);
 
-    if (!m_contentItem->m_items.contains(item)) {
-        m_contentItem->m_items.insert(qBound(0, pos, m_contentItem->m_items.length()), item);
-
-        connect(item, &QObject::destroyed, m_contentItem, [this, item]() {
-            removeItem(item);
-        });
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
-        attached->setOriginalParent(item->parentItem());
-        attached->setShouldDeleteOnRemove(item->parentItem() == nullptr && QQmlEngine::objectOwnership(item) == QQmlEngine::JavaScriptOwnership);
-        item->setParentItem(m_contentItem);
-
-        if (attached->globalHeader()) {
-            m_contentItem->connectHeader(nullptr, attached->globalHeader());
-        }
-        if (attached->globalFooter()) {
-            m_contentItem->connectFooter(nullptr, attached->globalFooter());
-        }
-        connect(attached, &ColumnViewAttached::globalHeaderChanged, m_contentItem, &ContentItem::connectHeader);
-        connect(attached, &ColumnViewAttached::globalFooterChanged, m_contentItem, &ContentItem::connectFooter);
+    if (m_contentItem->indexOf(item) < 0) {
+        m_contentItem->insertItemAt(qBound(0, pos, m_contentItem->m_items.length()), item);
+        m_contentItem->invalidateLayout(pos);
+        adoptItem(item);
 
         if (m_currentIndex >= pos) {
             ++m_currentIndex;
@@ -1383,6 +1897,166 @@ void ColumnView::replaceItem(int pos, QQuickItem *item)
     Q_EMIT contentChildrenChanged();
 }
 
+void ColumnView::insertDeferredItems(int pos, const QVariantList &items, const QVariantList &properties)
+{
+    QQmlContext *context = qmlContext(this);
+    pos = qBound(0, pos, m_contentItem->m_items.length());
+
+    int inserted = 0;
+    for (int i = 0; i < items.count(); ++i) {
+        const QVariant &entry = items.at(i);
+        QQuickItem *item = entry.value<QQuickItem *>();
+
+        if (item) {
+            if (m_contentItem->indexOf(item) >= 0) {
+                continue;
+            }
+        } else {
+            ContentItem::DeferredItem deferred;
+            deferred.properties = properties.value(i).toMap();
+            if (auto component = entry.value<QQmlComponent *>()) {
+                deferred.component = component;
+            } else if (entry.typeId() == QMetaType::QUrl || entry.typeId() == QMetaType::QString) {
+                deferred.url = context ? context->resolvedUrl(entry.toUrl()) : entry.toUrl();
+            }
+            if (!deferred.component && deferred.url.isEmpty()) {
+                qCWarning(LingmoUILayoutsLog) << "ColumnView::insertDeferredItems expects components, urls or items, got" << entry;
+                continue;
+            }
+
+            // Deleted on removal like the pages created from JavaScript
+            item = new QQuickItem;
+            QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+            m_contentItem->m_deferredItems.insert(item, deferred);
+        }
+
+        const int itemPos = pos + inserted;
+        m_contentItem->insertItemAt(itemPos, item);
+        m_contentItem->invalidateLayout(itemPos);
+        adoptItem(item);
+        ++inserted;
+
+        Q_EMIT itemInserted(itemPos, item);
+    }
+
+    if (inserted == 0) {
+        return;
+    }
+
+    if (m_currentIndex >= pos) {
+        m_currentIndex += inserted;
+        Q_EMIT currentIndexChanged();
+    }
+
+    // A single layout pass for all of them, which will tell the placeholders to be created
+    polish();
+    Q_EMIT contentChildrenChanged();
+}
+
+void ColumnView::adoptItem(QQuickItem *item)
+{
+    connect(item, &QObject::destroyed, m_contentItem, [this, item]() {
+        removeItem(item);
+    });
+    ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+    attached->setOriginalParent(item->parentItem());
+    attached->setShouldDeleteOnRemove(item->parentItem() == nullptr && QQmlEngine::objectOwnership(item) == QQmlEngine::JavaScriptOwnership);
+    item->setParentItem(m_contentItem);
+
+    if (attached->globalHeader()) {
+        m_contentItem->connectHeader(nullptr, attached->globalHeader());
+    }
+    if (attached->globalFooter()) {
+        m_contentItem->connectFooter(nullptr, attached->globalFooter());
+    }
+    connect(attached, &ColumnViewAttached::globalHeaderChanged, m_contentItem, &ContentItem::connectHeader);
+    connect(attached, &ColumnViewAttached::globalFooterChanged, m_contentItem, &ContentItem::connectFooter);
+}
+
+void ColumnView::createDeferredItem(QQuickItem *placeholder)
+{
+    const int index = m_contentItem->indexOf(placeholder);
+    auto it = m_contentItem->m_deferredItems.find(placeholder);
+    if (index < 0 || it == m_contentItem->m_deferredItems.end()) {
+        return;
+    }
+
+    QQmlComponent *component = it->component;
+    if (!component && !it->url.isEmpty()) {
+        component = m_contentItem->m_deferredComponents.value(it->url);
+        if (!component) {
+            QQmlEngine *engine = qmlEngine(this);
+            if (!engine) {
+                return;
+            }
+            component = new QQmlComponent(engine, it->url, QQmlComponent::PreferSynchronous, m_contentItem);
+            m_contentItem->m_deferredComponents.insert(it->url, component);
+        }
+        it->component = component;
+    }
+    if (!component) {
+        qCWarning(LingmoUILayoutsLog) << "The component of a deferred ColumnView item has been deleted";
+        // Nothing will ever fill that column, don't leave it blank
+        removeItem(placeholder);
+        return;
+    }
+
+    if (component->isLoading()) {
+        // Remote files, look again for the placeholders on screen once they are there
+        connect(component, &QQmlComponent::statusChanged, m_contentItem, &ContentItem::updateVisibleItems, Qt::UniqueConnection);
+        return;
+    }
+
+    const QVariantMap properties = it->properties;
+    m_contentItem->m_deferredItems.erase(it);
+
+    // Like Qt.createComponent(), files are evaluated in the context of whoever asked for them
+    QObject *object = component->createWithInitialProperties(properties, component->creationContext() ? nullptr : qmlContext(this));
+    auto item = qobject_cast<QQuickItem *>(object);
+    if (!item) {
+        qCWarning(LingmoUILayoutsLog) << "Could not create a deferred ColumnView item" << component->url() << component->errors();
+        delete object;
+        // Retrying would fail the same way on every layout pass, drop the column instead
+        removeItem(placeholder);
+        return;
+    }
+    QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+
+    // Swap the placeholder in place: nothing else moves and the current index stays the same
+    ColumnViewAttached *placeholderAttached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(placeholder, true));
+    placeholderAttached->setView(nullptr);
+    placeholderAttached->setIndex(-1);
+    disconnect(placeholderAttached, nullptr, m_contentItem, nullptr);
+    disconnect(placeholder, nullptr, m_contentItem, nullptr);
+    disconnect(placeholder, nullptr, this, nullptr);
+    if (m_contentItem->m_detachedItems.contains(placeholder)) {
+        m_contentItem->setDetached(placeholder, false);
+    }
+    m_contentItem->m_unplacedItems.removeAll(placeholder);
+    m_contentItem->m_attachedItems.removeAll(placeholder);
+
+    m_contentItem->replaceItemAt(index, item);
+    m_contentItem->invalidateLayout(index);
+    adoptItem(item);
+
+    if (m_contentItem->m_viewAnchorItem == placeholder) {
+        m_contentItem->m_viewAnchorItem = item;
+    }
+    if (m_currentItem == placeholder) {
+        m_currentItem = item;
+        item->forceActiveFocus();
+        Q_EMIT currentItemChanged();
+    }
+
+    placeholder->setVisible(false);
+    placeholder->deleteLater();
+
+    polish();
+    Q_EMIT contentChildrenChanged();
+    Q_EMIT itemRemoved(placeholder);
+    Q_EMIT itemInserted(index, item);
+}
+
 void ColumnView::moveItem(int from, int to)
 {
     if (m_contentItem->m_items.isEmpty() //
@@ -1391,7 +2065,8 @@ void ColumnView::moveItem(int from, int to)
         return;
     }
 
-    m_contentItem->m_items.move(from, to);
+    m_contentItem->moveItem(from, to);
+    m_contentItem->invalidateLayout(qMin(from, to));
     m_contentItem->m_shouldAnimate = true;
 
     if (from == m_currentIndex) {
@@ -1410,12 +2085,11 @@ void ColumnView::moveItem(int from, int to)
 
 QQuickItem *ColumnView::removeItem(QQuickItem *item)
 {
-    if (m_contentItem->m_items.isEmpty() || !m_contentItem->m_items.contains(item)) {
+    const int index = m_contentItem->indexOf(item);
+    if (index < 0) {
         return nullptr;
     }
 
-    const int index = m_contentItem->m_items.indexOf(item);
-
     // In order to keep the same current item we need to increase the current index if displaced
     if (m_currentIndex >= index) {
         setCurrentIndex(m_currentIndex - 1);
@@ -1499,19 +2173,21 @@ QQuickItem *ColumnView::pop()
 
 void ColumnView::clear()
 {
-    // Don't do an iterator on a list that gets progressively destroyed, treat it as a stack
+    // Don't do an iterator on a list that gets progressively destroyed, treat it as a stack.
+    // Popping from the end doesn't shift the remaining items
     while (!m_contentItem->m_items.isEmpty()) {
-        QQuickItem *item = m_contentItem->m_items.first();
+        QQuickItem *item = m_contentItem->m_items.last();
         removeItem(item);
     }
 
-    m_contentItem->m_items.clear();
+    m_contentItem->setItems({});
+    m_contentItem->invalidateLayout();
     Q_EMIT contentChildrenChanged();
 }
 
 bool ColumnView::containsItem(QQuickItem *item)
 {
-    return m_contentItem->m_items.contains(item);
+    return m_contentItem->indexOf(item) >= 0;
 }
 
 QQuickItem *ColumnView::itemAt(qreal x, qreal y)
@@ -1529,6 +2205,9 @@ void ColumnView::geometryChange(const QRectF &newGeometry, const QRectF &oldGeom
     m_contentItem->setY(m_topPadding);
     m_contentItem->setHeight(newGeometry.height() - m_topPadding - m_bottomPadding);
     m_contentItem->m_shouldAnimate = false;
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_contentItem->invalidateLayout();
+    }
     polish();
 
     m_contentItem->updateVisibleItems();
@@ -1554,7 +2233,7 @@ bool ColumnView::childMouseEventFilter(QQuickItem *item, QEvent *event)
         while (candidateItem->parentItem() && candidateItem->parentItem() != m_contentItem) {
             candidateItem = candidateItem->parentItem();
         }
-        if (int idx = m_contentItem->m_items.indexOf(candidateItem); idx >= 0 && candidateItem->parentItem() == m_contentItem) {
+        if (int idx = m_contentItem->indexOf(candidateItem); idx >= 0 && candidateItem->parentItem() == m_contentItem) {
             setCurrentIndex(idx);
         }
 
@@ -1564,7 +2243,7 @@ bool ColumnView::childMouseEventFilter(QQuickItem *item, QEvent *event)
             return false;
         }
 
-        m_contentItem->m_slideAnim->stop();
+        m_contentItem->stopSlide();
         if (item->property("preventStealing").toBool()) {
             m_contentItem->snapToItem();
             return false;
@@ -1786,7 +2465,7 @@ void ColumnView::mouseUngrabEvent()
 {
     m_mouseDown = false;
 
-    if (m_contentItem->m_slideAnim->state() != QAbstractAnimation::Running) {
+    if (!m_contentItem->isSliding()) {
         m_contentItem->snapToItem();
     }
     m_contentItem->m_lastDragDelta = 0;
@@ -1803,6 +2482,7 @@ void ColumnView::classBegin()
 {
     auto syncColumnWidth = [this]() {
         m_contentItem->m_columnWidth = privateQmlComponentsPoolSelf->instance(qmlEngine(this))->m_units->gridUnit() * 20;
+        m_contentItem->invalidateLayout();
         Q_EMIT columnWidthChanged();
     };
 
@@ -1817,6 +2497,8 @@ void ColumnView::classBegin()
     connect(QmlComponentsPoolSingleton::instance(qmlEngine(this)), &QmlComponentsPool::longDurationChanged, this, syncDuration);
     syncDuration();
 
+    connect(QmlComponentsPoolSingleton::instance(qmlEngine(this)), &QmlComponentsPool::largeSpacingChanged, m_contentItem, &ContentItem::updateSeparators);
+
     QQuickItem::classBegin();
 }
 
@@ -1828,6 +2510,12 @@ void ColumnView::componentComplete()
 
 void ColumnView::updatePolish()
 {
+    // Create the deferred columns which got on screen during the last layout pass
+    const QList<QQuickItem *> placeholders = std::exchange(m_contentItem->m_pendingDeferredItems, {});
+    for (QQuickItem *placeholder : placeholders) {
+        createDeferredItem(placeholder);
+    }
+
     m_contentItem->layoutItems();
 }
 
@@ -1853,7 +2541,7 @@ void ColumnView::contentChildren_append(QQmlListProperty<QQuickItem> *prop, QQui
         return;
     }
 
-    view->m_contentItem->m_items.append(item);
+    view->m_contentItem->insertItemAt(view->m_contentItem->m_items.count(), item);
     connect(item, &QObject::destroyed, view->m_contentItem, [view, item]() {
         view->removeItem(item);
     });
@@ -1895,7 +2583,8 @@ void ColumnView::contentChildren_clear(QQmlListProperty<QQuickItem> *prop)
         return;
     }
 
-    return view->m_contentItem->m_items.clear();
+    view->m_contentItem->setItems({});
+    view->m_contentItem->invalidateLayout();
 }
 
 QQmlListProperty<QQuickItem> ColumnView::contentChildren()
@@ -1924,7 +2613,7 @@ void ColumnView::contentData_append(QQmlListProperty<QObject> *prop, QObject *ob
         connect(item, SIGNAL(modelChanged()), view->m_contentItem, SLOT(updateRepeaterModel()));
 
     } else if (item) {
-        view->m_contentItem->m_items.append(item);
+        view->m_contentItem->insertItemAt(view->m_contentItem->m_items.count(), item);
         connect(item, &QObject::destroyed, view->m_contentItem, [view, item]() {
             view->removeItem(item);
         });
@@ -10,6 +10,8 @@
 #include <QQuickItem>
 #include <QVariant>
 
+#include "layoutstatistics.h"
+
 class ContentItem;
 class ColumnView;
 
@@ -30,6 +32,70 @@ public:
     bool accepted = false;
 };
 
+/**
+ * Counts the calls and the time spent by a ColumnView in its most expensive operations,
+ * for instance to report how much navigating between pages costs on real devices.
+ *
+ * Times are in milliseconds. A layout pass updates the visible columns, which updates
+ * the separators: the time of the nested operations is counted in both.
+ * Nothing is measured until the statistics object is accessed for the first time,
+ * so views nobody profiles don't pay for it.
+ * Each measure is also logged on the kf.lingmoui.layouts.columnview category when its debug output is enabled.
+ * @see ColumnView::statistics
+ * @since 6.5
+ */
+class ColumnViewStatistics : public LayoutStatistics
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+
+    /**
+     * How many times the columns have been laid out, and the time it took.
+     */
+    Q_PROPERTY(int layoutCount READ layoutCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal layoutTime READ layoutTime NOTIFY changed FINAL)
+
+    /**
+     * How many times the pinned columns have been moved to follow contentX, and the time it took.
+     */
+    Q_PROPERTY(int pinnedLayoutCount READ pinnedLayoutCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal pinnedLayoutTime READ pinnedLayoutTime NOTIFY changed FINAL)
+
+    /**
+     * How many times the visible columns have been updated, and the time it took.
+     */
+    Q_PROPERTY(int visibleItemsCount READ visibleItemsCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal visibleItemsTime READ visibleItemsTime NOTIFY changed FINAL)
+
+    /**
+     * How many times the column separators have been updated, and the time it took.
+     */
+    Q_PROPERTY(int separatorsCount READ separatorsCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal separatorsTime READ separatorsTime NOTIFY changed FINAL)
+
+public:
+    enum Operation {
+        Layout,
+        PinnedLayout,
+        VisibleItems,
+        Separators,
+        OperationCount,
+    };
+
+    ColumnViewStatistics(QObject *parent = nullptr);
+    ~ColumnViewStatistics() override;
+
+    int layoutCount() const;
+    qreal layoutTime() const;
+    int pinnedLayoutCount() const;
+    qreal pinnedLayoutTime() const;
+    int visibleItemsCount() const;
+    qreal visibleItemsTime() const;
+    int separatorsCount() const;
+    qreal separatorsTime() const;
+};
+
 /**
  * This is an attached property to every item that is inserted in the ColumnView,
  * used to access the view and page information such as the position and information for layouting, such as fillWidth
@@ -262,6 +328,41 @@ class ColumnView : public QQuickItem
      */
     Q_PROPERTY(bool acceptsMouse READ acceptsMouse WRITE setAcceptsMouse NOTIFY acceptsMouseChanged FINAL)
 
+    /**
+     * If true, columns further than virtualizationDistance from the viewport are culled,
+     * which takes them out of rendering without changing their visible property. They keep
+     * their width, their place in the layout and their state, and are rendered again as soon
+     * as they get close to the viewport.
+     * Pinned columns and the current column are never hidden.
+     * default: false
+     * @since 6.5
+     */
+    Q_PROPERTY(bool virtualizeColumns READ virtualizeColumns WRITE setVirtualizeColumns NOTIFY virtualizeColumnsChanged FINAL)
+
+    /**
+     * How far from the edges of the viewport, in pixels, columns stay shown when virtualizeColumns is true.
+     * default: 0, only the columns overlapping the viewport are shown
+     * @since 6.5
+     */
+    Q_PROPERTY(qreal virtualizationDistance READ virtualizationDistance WRITE setVirtualizationDistance NOTIFY virtualizationDistanceChanged FINAL)
+
+    /**
+     * If true, the scroll animation between columns runs on the render thread, like the Animator types,
+     * so it stays smooth while the GUI thread is busy, for instance creating the page being pushed.
+     * contentX only gets its final value when the animation ends.
+     * Views with pinned columns always animate on the GUI thread, as those columns follow every step of the scroll.
+     * default: false
+     * @since 6.5
+     */
+    Q_PROPERTY(bool threadedScrollAnimation READ threadedScrollAnimation WRITE setThreadedScrollAnimation NOTIFY threadedScrollAnimationChanged FINAL)
+
+    /**
+     * Counters of the time the view spends laying out and updating its columns, for profiling.
+     * @see ColumnViewStatistics
+     * @since 6.5
+     */
+    Q_PROPERTY(ColumnViewStatistics *statistics READ statistics CONSTANT FINAL)
+
     // Default properties
     /**
      * Every column item the view contains
@@ -333,6 +434,17 @@ public:
     bool acceptsMouse() const;
     void setAcceptsMouse(bool accepts);
 
+    bool virtualizeColumns() const;
+    void setVirtualizeColumns(bool virtualize);
+
+    qreal virtualizationDistance() const;
+    void setVirtualizationDistance(qreal distance);
+
+    bool threadedScrollAnimation() const;
+    void setThreadedScrollAnimation(bool threaded);
+
+    ColumnViewStatistics *statistics();
+
     /**
      * @brief This method removes all the items after the specified item or
      * index from the view and returns the last item that was removed.
@@ -447,6 +559,30 @@ public Q_SLOTS:
      */
     void replaceItem(int pos, QQuickItem *item);
 
+    /**
+     * Inserts several items at once in the view at a given position, creating them only when they are shown.
+     *
+     * Each entry of @p items can be a Component, the url of a QML file or an existing item.
+     * Components and urls are instantiated, with the matching entry of @p properties as initial
+     * properties, the first time their column enters the viewport. Until then an empty placeholder
+     * item takes their place, sized like any other column, so restoring a deep navigation path
+     * doesn't block on creating pages nobody looks at.
+     *
+     * The placeholders are plain items: they are reported by itemInserted(), are part of
+     * contentChildren and can be the currentItem like any other column.
+     * Once the real item is created it replaces its placeholder at the same index,
+     * which is reported as itemRemoved() for the placeholder followed by itemInserted()
+     * for the new item. If creating it fails, the placeholder is removed.
+     *
+     * The current Item will not be changed, currentIndex will be adjusted
+     * accordingly if needed to keep the same current item.
+     * @param pos the position the first item will be inserted in
+     * @param items the components, urls or items to insert
+     * @param properties the initial properties of each item, can be left empty
+     * @since 6.5
+     */
+    void insertDeferredItems(int pos, const QVariantList &items, const QVariantList &properties = QVariantList());
+
     /**
      * Move an item inside the view.
      * The currentIndex property may be changed in order to keep currentItem the same.
@@ -513,6 +649,9 @@ Q_SIGNALS:
     void contentWidthChanged();
     void interactiveChanged();
     void acceptsMouseChanged();
+    void virtualizeColumnsChanged();
+    void virtualizationDistanceChanged();
+    void threadedScrollAnimationChanged();
     void scrollDurationChanged();
     void separatorVisibleChanged();
     void leadingVisibleItemChanged();
@@ -531,6 +670,10 @@ private:
     static QObject *contentData_at(QQmlListProperty<QObject> *prop, qsizetype index);
     static void contentData_clear(QQmlListProperty<QObject> *prop);
 
+    // Reparents a new column and connects it, once it's in m_contentItem->m_items
+    void adoptItem(QQuickItem *item);
+    void createDeferredItem(QQuickItem *placeholder);
+
     QList<QObject *> m_contentData;
 
     ContentItem *m_contentItem;
@@ -551,6 +694,9 @@ private:
     bool m_separatorVisible = true;
     bool m_complete = false;
     bool m_acceptsMouse = false;
+    bool m_virtualizeColumns = false;
+    qreal m_virtualizationDistance = 0;
+    bool m_threadedScrollAnimation = false;
 };
 
 QML_DECLARE_TYPEINFO(ColumnView, QML_HAS_ATTACHED_PROPERTIES)
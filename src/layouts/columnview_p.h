@@ -9,7 +9,11 @@
 #include "columnview.h"
 
 #include <QPointer>
+#include <QSet>
 #include <QQuickItem>
+#include <QUrl>
+
+#include <limits>
 
 class QPropertyAnimation;
 class QQmlComponent;
@@ -17,6 +21,7 @@ namespace LingmoUI
 {
 namespace Platform
 {
+class PlatformTheme;
 class Units;
 }
 }
@@ -29,16 +34,46 @@ public:
     QmlComponentsPool(QQmlEngine *engine);
     ~QmlComponentsPool() override;
 
-    QQmlComponent *m_leadingSeparatorComponent = nullptr;
-    QQmlComponent *m_trailingSeparatorComponent = nullptr;
+    QQmlComponent *slideAnimatorComponent();
+
     LingmoUI::Platform::Units *m_units = nullptr;
 
 Q_SIGNALS:
     void gridUnitChanged();
     void longDurationChanged();
+    void largeSpacingChanged();
 
 private:
-    QObject *m_instance = nullptr;
+    QQmlEngine *m_engine;
+    QQmlComponent *m_slideAnimatorComponent = nullptr;
+};
+
+/**
+ * Draws the separators between the columns of a ColumnView as plain rectangle nodes.
+ * It has no size of its own, so it never shows up in childAt() lookups on the content item.
+ */
+class ColumnSeparators : public QQuickItem
+{
+    Q_OBJECT
+
+public:
+    static constexpr qreal separatorWidth = 1;
+
+    ColumnSeparators(QQuickItem *parent = nullptr);
+    ~ColumnSeparators() override;
+
+    void setSeparators(const QList<QRectF> &rects);
+
+protected:
+    void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
+    QSGNode *updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data) override;
+
+private:
+    void updateColor();
+
+    LingmoUI::Platform::PlatformTheme *m_theme = nullptr;
+    QList<QRectF> m_rects;
+    QColor m_color;
 };
 
 class ContentItem : public QQuickItem
@@ -51,14 +86,30 @@ public:
 
     void layoutItems();
     void layoutPinnedItems();
-    qreal childWidth(QQuickItem *child);
+    void invalidateLayout(int fromIndex = 0);
+    qreal childWidth(int index);
     void updateVisibleItems();
+    bool isInViewport(QQuickItem *item) const;
+    std::pair<int, int> columnRange(qreal left, qreal right) const;
+    void updateDetachedItems(qreal left, qreal right);
+    void setDetached(QQuickItem *item, bool detached);
+    void resetDetachedItems();
     void forgetItem(QQuickItem *item);
-    QQuickItem *ensureLeadingSeparator(QQuickItem *item);
-    QQuickItem *ensureTrailingSeparator(QQuickItem *item);
+    void updateSeparators();
+
+    int indexOf(QQuickItem *item) const;
+    void insertItemAt(int pos, QQuickItem *item);
+    void moveItem(int from, int to);
+    void removeItemAt(int pos);
+    void replaceItemAt(int pos, QQuickItem *item);
+    void setItems(const QList<QQuickItem *> &items);
+    void updateColumnData(QQuickItem *item);
 
     void setBoundedX(qreal x);
     void animateX(qreal x);
+    void stopSlide();
+    bool isSliding() const;
+    qreal slideTarget() const;
     void snapToItem();
 
     void connectHeader(QQuickItem *oldHeader, QQuickItem *newHeader);
@@ -67,6 +118,9 @@ public:
     inline qreal viewportLeft() const;
     inline qreal viewportRight() const;
 
+Q_SIGNALS:
+    void slideFinished();
+
 protected:
     void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
@@ -74,17 +128,65 @@ protected:
 private Q_SLOTS:
     void syncItemsOrder();
     void updateRepeaterModel();
+    void slideAnimatorFinished();
 
 private:
     ColumnView *m_view;
     QQuickItem *m_globalHeaderParent;
     QQuickItem *m_globalFooterParent;
+    ColumnSeparators *m_separators;
     QPropertyAnimation *m_slideAnim;
+    // XAnimator running the slide on the render thread, see ColumnView::threadedScrollAnimation
+    QObject *m_slideAnimator = nullptr;
+    bool m_slideAnimatorRunning = false;
+    qreal m_slideAnimatorTarget = 0;
+    // Only created once somebody asked for ColumnView::statistics
+    ColumnViewStatistics *m_statistics = nullptr;
+
+    // Placeholders inserted by ColumnView::insertDeferredItems, with what to create in their place
+    struct DeferredItem {
+        QPointer<QQmlComponent> component;
+        QUrl url;
+        QVariantMap properties;
+    };
+    QHash<QQuickItem *, DeferredItem> m_deferredItems;
+    // Placeholders which have been shown, to be replaced at the next polish
+    QList<QQuickItem *> m_pendingDeferredItems;
+    QHash<QUrl, QQmlComponent *> m_deferredComponents;
+
     QList<QQuickItem *> m_items;
+    // Position of every item of m_items. Entries are refreshed lazily: the ones below
+    // m_validItemIndices are exact, the others may be off after an insertion, move or removal.
+    mutable QHash<QQuickItem *, int> m_itemIndices;
+    mutable int m_validItemIndices = 0;
+    // What the layout needs to know of every item of m_items, at the same index, so the per frame
+    // loops don't go through the QML attached property lookup. Kept up to date by updateColumnData().
+    QList<ColumnViewAttached *> m_columnAttached;
+    QList<qreal> m_columnReservedSpace;
+    QList<bool> m_columnFillWidth;
+    QList<bool> m_columnPinned;
+
+    // Running totals of the last layout pass: entry i holds the values accumulated
+    // before the column at position i of m_items, the last entry the totals of the view.
+    struct LayoutPrefix {
+        qreal x = 0;
+        qreal implicitWidth = 0;
+        qreal implicitHeight = 0;
+        int index = 0;
+    };
+    QList<LayoutPrefix> m_layoutPrefix;
+    // Positions in m_layoutPrefix of the pinned columns, in layout order
+    QList<int> m_pinnedColumns;
+    int m_firstDirtyColumn = 0;
+    bool m_layoutReversed = false;
+    // Columns added since the last updateVisibleItems(), whose viewport state is still unknown
+    QList<QQuickItem *> m_unplacedItems;
+    // Columns culled by ColumnView::virtualizeColumns, they stay visible and keep their size and place in the layout
+    QSet<QQuickItem *> m_detachedItems;
+    // Columns close enough to the viewport to stay shown at the last updateDetachedItems()
+    QList<QQuickItem *> m_attachedItems;
     QList<QObject *> m_visibleItems;
     QPointer<QQuickItem> m_viewAnchorItem;
-    QHash<QQuickItem *, QQuickItem *> m_leadingSeparators;
-    QHash<QQuickItem *, QQuickItem *> m_trailingSeparators;
     QHash<QObject *, QObject *> m_models;
 
     qreal m_leftPinnedSpace = 361;
@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "layoutstatistics.h"
+
+#include <algorithm>
+
+LayoutStatistics::LayoutStatistics(int operationCount, QObject *parent)
+    : QObject(parent)
+    , m_counts(operationCount, 0)
+    , m_times(operationCount, 0)
+{
+}
+
+LayoutStatistics::~LayoutStatistics()
+{
+}
+
+int LayoutStatistics::count(int operation) const
+{
+    return m_counts[operation];
+}
+
+qreal LayoutStatistics::time(int operation) const
+{
+    return m_times[operation] / 1000000.0;
+}
+
+void LayoutStatistics::record(int operation, qint64 nsecs)
+{
+    ++m_counts[operation];
+    m_times[operation] += nsecs;
+    queueChanged();
+}
+
+void LayoutStatistics::reset()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    std::fill(m_times.begin(), m_times.end(), 0);
+    queueChanged();
+}
+
+void LayoutStatistics::queueChanged()
+{
+    // Layouts run several times per frame while resizing or scrolling, notify only once
+    if (m_changeQueued) {
+        return;
+    }
+
+    m_changeQueued = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            m_changeQueued = false;
+            Q_EMIT changed();
+        },
+        Qt::QueuedConnection);
+}
+
+#include "moc_layoutstatistics.cpp"
@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QObject>
+#include <qqmlregistration.h>
+
+#include <vector>
+
+/**
+ * Base of the statistics objects of the layouts, such as ColumnViewStatistics.
+ *
+ * Keeps a call count and a total time for each of the operations a subclass
+ * enumerates, which exposes them as properties notified by changed().
+ */
+class LayoutStatistics : public QObject
+{
+    Q_OBJECT
+    QML_ANONYMOUS
+
+public:
+    ~LayoutStatistics() override;
+
+    /**
+     * Adds a call of @p operation which took @p nsecs nanoseconds
+     */
+    void record(int operation, qint64 nsecs);
+
+    /**
+     * Sets all the counters back to zero
+     */
+    Q_INVOKABLE virtual void reset();
+
+Q_SIGNALS:
+    /**
+     * Emitted at most once per event loop iteration when any counter changed
+     */
+    void changed();
+
+protected:
+    LayoutStatistics(int operationCount, QObject *parent);
+
+    int count(int operation) const;
+    // In milliseconds
+    qreal time(int operation) const;
+
+    void queueChanged();
+
+private:
+    std::vector<int> m_counts;
+    std::vector<qint64> m_times;
+    bool m_changeQueued = false;
+};
+
+/**
+ * Measures the scope it lives in for the statistics of a layout and for the timing
+ * debug output of @p category. Does nothing when neither of them is enabled.
+ */
+template<const QLoggingCategory &(*category)()>
+class LayoutTimer
+{
+public:
+    LayoutTimer(LayoutStatistics *statistics, int operation, const char *name, int items)
+        : m_statistics(statistics)
+        , m_operation(operation)
+        , m_name(name)
+        , m_items(items)
+        , m_logging(category().isDebugEnabled())
+    {
+        if (m_statistics || m_logging) {
+            m_timer.start();
+        }
+    }
+
+    ~LayoutTimer()
+    {
+        if (!m_timer.isValid()) {
+            return;
+        }
+
+        const qint64 elapsed = m_timer.nsecsElapsed();
+        if (m_statistics) {
+            m_statistics->record(m_operation, elapsed);
+        }
+        if (m_logging) {
+            qCDebug(category).nospace() << m_name << " took " << elapsed / 1000 << "us for " << m_items << " items";
+        }
+    }
+
+    Q_DISABLE_COPY_MOVE(LayoutTimer)
+
+private:
+    LayoutStatistics *m_statistics;
+    int m_operation;
+    const char *m_name;
+    int m_items;
+    bool m_logging;
+    QElapsedTimer m_timer;
+};
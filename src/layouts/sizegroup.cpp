@@ -28,23 +28,28 @@ QQuickItem *SizeGroup::itemAt(QQmlListProperty<QQuickItem> *prop, qsizetype inde
 
 void SizeGroup::clearItems(QQmlListProperty<QQuickItem> *prop)
 {
-    for (const auto &item : std::as_const(pThis->m_items)) {
-        QObject::disconnect(pThis->m_connections[item].first);
-        QObject::disconnect(pThis->m_connections[item].second);
+    for (const auto &data : std::as_const(pThis->m_itemData)) {
+        QObject::disconnect(data.widthConnection);
+        QObject::disconnect(data.heightConnection);
+        QObject::disconnect(data.destroyedConnection);
     }
+    pThis->m_itemData.clear();
     pThis->m_items.clear();
 }
 
 void SizeGroup::connectItem(QQuickItem *item)
 {
-    auto conn1 = connect(item, &QQuickItem::implicitWidthChanged, this, [this]() {
-        adjustItems(Mode::Width);
+    ItemData &data = m_itemData[item];
+    data.widthConnection = connect(item, &QQuickItem::implicitWidthChanged, this, [this]() {
+        queueAdjustItems(Mode::Width);
     });
-    auto conn2 = connect(item, &QQuickItem::implicitHeightChanged, this, [this]() {
-        adjustItems(Mode::Height);
+    data.heightConnection = connect(item, &QQuickItem::implicitHeightChanged, this, [this]() {
+        queueAdjustItems(Mode::Height);
     });
-    m_connections[item] = qMakePair(conn1, conn2);
-    adjustItems(m_mode);
+    data.destroyedConnection = connect(item, &QObject::destroyed, this, [this, item]() {
+        m_itemData.remove(item);
+    });
+    queueAdjustItems(m_mode);
 }
 
 QQmlListProperty<QQuickItem> SizeGroup::items()
@@ -59,6 +64,11 @@ QQmlListProperty<QQuickItem> SizeGroup::items()
 
 void SizeGroup::relayout()
 {
+    // Write everything again, even what looks up to date
+    for (auto &data : m_itemData) {
+        data.width = -1.0;
+        data.height = -1.0;
+    }
     adjustItems(Mode::Both);
 }
 
@@ -67,12 +77,29 @@ void SizeGroup::componentComplete()
     adjustItems(Mode::Both);
 }
 
-void SizeGroup::adjustItems(Mode whatChanged)
+void SizeGroup::queueAdjustItems(Modes whatChanged)
 {
-    if (m_mode == Mode::Width && whatChanged == Mode::Height) {
+    m_pendingChanges |= whatChanged;
+    if (m_adjustQueued) {
         return;
     }
-    if (m_mode == Mode::Height && whatChanged == Mode::Width) {
+
+    m_adjustQueued = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            const Modes changes = m_pendingChanges;
+            m_pendingChanges = Mode::None;
+            m_adjustQueued = false;
+            adjustItems(changes);
+        },
+        Qt::QueuedConnection);
+}
+
+void SizeGroup::adjustItems(Modes whatChanged)
+{
+    // Nothing to do when only a dimension this group doesn't sync changed
+    if (!(whatChanged & m_mode)) {
         return;
     }
 
@@ -109,20 +136,29 @@ void SizeGroup::adjustItems(Mode whatChanged)
             continue;
         }
 
-        switch (m_mode) {
-        case Mode::Width:
-            QQmlProperty(item, QStringLiteral("Layout.preferredWidth"), qmlContext(item)).write(maxWidth);
-            break;
-        case Mode::Height:
-            QQmlProperty(item, QStringLiteral("Layout.preferredHeight"), qmlContext(item)).write(maxHeight);
-            break;
-        case Mode::Both:
-            QQmlProperty(item, QStringLiteral("Layout.preferredWidth"), qmlContext(item)).write(maxWidth);
-            QQmlProperty(item, QStringLiteral("Layout.preferredHeight"), qmlContext(item)).write(maxHeight);
-            break;
-        case Mode::None:
-            break;
+        auto it = m_itemData.find(item);
+        if (it != m_itemData.end()) {
+            writeSize(item, *it, m_mode, maxWidth, maxHeight);
+        }
+    }
+}
+
+void SizeGroup::writeSize(QQuickItem *item, ItemData &data, Mode mode, qreal width, qreal height)
+{
+    if ((mode & Mode::Width) && width != data.width) {
+        if (!data.preferredWidth.isValid()) {
+            data.preferredWidth = QQmlProperty(item, QStringLiteral("Layout.preferredWidth"), qmlContext(item));
+        }
+        data.preferredWidth.write(width);
+        data.width = width;
+    }
+
+    if ((mode & Mode::Height) && height != data.height) {
+        if (!data.preferredHeight.isValid()) {
+            data.preferredHeight = QQmlProperty(item, QStringLiteral("Layout.preferredHeight"), qmlContext(item));
         }
+        data.preferredHeight.write(height);
+        data.height = height;
     }
 }
 
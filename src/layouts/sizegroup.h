@@ -6,12 +6,12 @@
 
 #pragma once
 
-#include <QMap>
+#include <QHash>
 #include <QObject>
-#include <QPair>
 #include <QPointer>
 #include <QQmlListProperty>
 #include <QQmlParserStatus>
+#include <QQmlProperty>
 #include <QQuickItem>
 
 /**
@@ -34,9 +34,23 @@ public:
     Q_DECLARE_FLAGS(Modes, Mode)
 
 private:
+    struct ItemData {
+        QMetaObject::Connection widthConnection;
+        QMetaObject::Connection heightConnection;
+        QMetaObject::Connection destroyedConnection;
+        // Resolved once, looking attached properties up by name is expensive
+        QQmlProperty preferredWidth;
+        QQmlProperty preferredHeight;
+        // What was last written, to skip writing the same again
+        qreal width = -1.0;
+        qreal height = -1.0;
+    };
+
     Mode m_mode = None;
     QList<QPointer<QQuickItem>> m_items;
-    QMap<QQuickItem *, QPair<QMetaObject::Connection, QMetaObject::Connection>> m_connections;
+    QHash<QQuickItem *, ItemData> m_itemData;
+    Modes m_pendingChanges;
+    bool m_adjustQueued = false;
 
 public:
     /**
@@ -51,7 +65,12 @@ public:
     Q_PROPERTY(QQmlListProperty<QQuickItem> items READ items CONSTANT FINAL)
     QQmlListProperty<QQuickItem> items();
 
-    void adjustItems(Mode whatChanged);
+    void adjustItems(Modes whatChanged);
+    /**
+     * Adjusts the items once control returns to the event loop, so that many
+     * size changes in a row, like while items are loaded, cost a single pass.
+     */
+    void queueAdjustItems(Modes whatChanged);
     void connectItem(QQuickItem *item);
 
     /**
@@ -68,6 +87,8 @@ public:
     void componentComplete() override;
 
 private:
+    void writeSize(QQuickItem *item, ItemData &data, Mode mode, qreal width, qreal height);
+
     static void appendItem(QQmlListProperty<QQuickItem> *prop, QQuickItem *value);
     static qsizetype itemCount(QQmlListProperty<QQuickItem> *prop);
     static QQuickItem *itemAt(QQmlListProperty<QQuickItem> *prop, qsizetype index);
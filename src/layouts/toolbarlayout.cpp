@@ -6,6 +6,7 @@
 
 #include "toolbarlayout.h"
 
+#include <algorithm>
 #include <cmath>
 #include <unordered_map>
 
@@ -15,6 +16,91 @@
 
 #include "loggingcategory.h"
 #include "toolbarlayoutdelegate.h"
+#include "toolbarlayoutlogging.h"
+
+ToolBarLayoutStatistics::ToolBarLayoutStatistics(QObject *parent)
+    : LayoutStatistics(OperationCount, parent)
+{
+}
+
+ToolBarLayoutStatistics::~ToolBarLayoutStatistics()
+{
+}
+
+int ToolBarLayoutStatistics::implicitSizeCount() const
+{
+    return count(ImplicitSize);
+}
+
+qreal ToolBarLayoutStatistics::implicitSizeTime() const
+{
+    return time(ImplicitSize);
+}
+
+int ToolBarLayoutStatistics::fitCount() const
+{
+    return count(Fit);
+}
+
+qreal ToolBarLayoutStatistics::fitTime() const
+{
+    return time(Fit);
+}
+
+int ToolBarLayoutStatistics::layoutCount() const
+{
+    return count(Layout);
+}
+
+qreal ToolBarLayoutStatistics::layoutTime() const
+{
+    return time(Layout);
+}
+
+int ToolBarLayoutStatistics::incubationCount() const
+{
+    return count(Incubation);
+}
+
+qreal ToolBarLayoutStatistics::incubationTime() const
+{
+    return time(Incubation);
+}
+
+int ToolBarLayoutStatistics::recycledCount() const
+{
+    return m_recycledCount;
+}
+
+int ToolBarLayoutStatistics::hiddenCount() const
+{
+    return m_hiddenCount;
+}
+
+void ToolBarLayoutStatistics::recordRecycled()
+{
+    ++m_recycledCount;
+    queueChanged();
+}
+
+void ToolBarLayoutStatistics::setHiddenCount(int count)
+{
+    if (count == m_hiddenCount) {
+        return;
+    }
+
+    m_hiddenCount = count;
+    queueChanged();
+}
+
+void ToolBarLayoutStatistics::reset()
+{
+    m_recycledCount = 0;
+    m_hiddenCount = 0;
+    LayoutStatistics::reset();
+}
+
+using ToolBarLayoutTimer = LayoutTimer<LingmoUIToolBarLayoutLog>;
 
 ToolBarLayoutAttached::ToolBarLayoutAttached(QObject *parent)
     : QObject(parent)
@@ -28,7 +114,12 @@ QObject *ToolBarLayoutAttached::action() const
 
 void ToolBarLayoutAttached::setAction(QObject *action)
 {
+    if (action == m_action) {
+        return;
+    }
+
     m_action = action;
+    Q_EMIT actionChanged();
 }
 
 class ToolBarLayoutPrivate
@@ -49,11 +140,15 @@ public:
     }
 
     void calculateImplicitSize();
+    void fitDelegates();
     void performLayout();
+    void updateSortedDelegates();
+    void removeDelegates();
     QList<ToolBarLayoutDelegate *> createDelegates();
     ToolBarLayoutDelegate *createDelegate(QObject *action);
     qreal layoutStart(qreal layoutWidth);
     void maybeHideDelegate(int index, qreal &currentWidth, qreal totalWidth);
+    static void showPreferred(ToolBarLayoutDelegate *delegate);
 
     QList<QObject *> actions;
     ToolBarLayout::ActionsProperty actionsProperty;
@@ -71,9 +166,28 @@ public:
     bool completed = false;
     bool actionsChanged = false;
     bool implicitSizeValid = false;
+    bool fitValid = false;
+    bool sortedDelegatesValid = false;
 
     std::unordered_map<QObject *, std::unique_ptr<ToolBarLayoutDelegate>> delegates;
     QList<ToolBarLayoutDelegate *> sortedDelegates;
+    ToolBarDelegateWidths delegateWidths;
+
+    // Measured by calculateImplicitSize(), these only depend on the delegates,
+    // so fitDelegates() can reuse them as long as only the width changes.
+    QList<ToolBarLayoutDelegate *> layoutDelegates;
+    // The end of each of layoutDelegates, when all of them are shown
+    QList<qreal> cumulativeWidths;
+    QList<QObject *> alwaysHiddenActions;
+    qreal delegatesWidth = 0.0;
+    qreal delegatesHeight = 0.0;
+    bool hasKeepVisible = false;
+    // How many of layoutDelegates were shown by the last fit, -1 if they aren't simply the first ones
+    int fitBreakpoint = -1;
+    // Visible delegates maybeHideDelegate() can still hide or collapse, the last one first
+    QList<ToolBarLayoutDelegate *> hideCandidates;
+    QList<ToolBarLayoutDelegate *> collapseCandidates;
+
     QQuickItem *moreButtonInstance = nullptr;
     ToolBarDelegateIncubator *moreButtonIncubator = nullptr;
     bool shouldShowMoreButton = false;
@@ -82,7 +196,7 @@ public:
     QList<QObject *> removedActions;
     QTimer *removalTimer = nullptr;
 
-    QElapsedTimer performanceTimer;
+    ToolBarLayoutStatistics *statistics = nullptr;
 
     static void appendAction(ToolBarLayout::ActionsProperty *list, QObject *action);
     static qsizetype actionCount(ToolBarLayout::ActionsProperty *list);
@@ -108,12 +222,7 @@ ToolBarLayout::ToolBarLayout(QQuickItem *parent)
     d->removalTimer->setInterval(1000);
     d->removalTimer->setSingleShot(true);
     connect(d->removalTimer, &QTimer::timeout, this, [this]() {
-        for (auto action : std::as_const(d->removedActions)) {
-            if (!d->actions.contains(action)) {
-                d->delegates.erase(action);
-            }
-        }
-        d->removedActions.clear();
+        d->removeDelegates();
     });
 }
 
@@ -133,15 +242,18 @@ void ToolBarLayout::addAction(QObject *action)
     }
     d->actions.append(action);
     d->actionsChanged = true;
+    d->sortedDelegatesValid = false;
 
     connect(action, &QObject::destroyed, this, [this](QObject *action) {
         auto itr = d->delegates.find(action);
         if (itr != d->delegates.end()) {
             d->delegates.erase(itr);
         }
+        d->delegateWidths.remove(action);
 
         d->actions.removeOne(action);
         d->actionsChanged = true;
+        d->sortedDelegatesValid = false;
 
         relayout();
     });
@@ -160,6 +272,7 @@ void ToolBarLayout::removeAction(QObject *action)
     d->removedActions.append(action);
     d->removalTimer->start();
     d->actionsChanged = true;
+    d->sortedDelegatesValid = false;
 
     relayout();
 }
@@ -174,8 +287,10 @@ void ToolBarLayout::clearActions()
     }
 
     d->removedActions.append(d->actions);
+    d->removalTimer->start();
     d->actions.clear();
     d->actionsChanged = true;
+    d->sortedDelegatesValid = false;
 
     relayout();
 }
@@ -198,6 +313,8 @@ void ToolBarLayout::setFullDelegate(QQmlComponent *newFullDelegate)
 
     d->fullDelegate = newFullDelegate;
     d->delegates.clear();
+    d->delegateWidths.clear();
+    d->sortedDelegatesValid = false;
     relayout();
     Q_EMIT fullDelegateChanged();
 }
@@ -215,6 +332,8 @@ void ToolBarLayout::setIconDelegate(QQmlComponent *newIconDelegate)
 
     d->iconDelegate = newIconDelegate;
     d->delegates.clear();
+    d->delegateWidths.clear();
+    d->sortedDelegatesValid = false;
     relayout();
     Q_EMIT iconDelegateChanged();
 }
@@ -235,6 +354,7 @@ void ToolBarLayout::setMoreButton(QQmlComponent *newMoreButton)
         d->moreButtonInstance->deleteLater();
         d->moreButtonInstance = nullptr;
     }
+    d->sortedDelegatesValid = false;
     relayout();
     Q_EMIT moreButtonChanged();
 }
@@ -313,6 +433,19 @@ void ToolBarLayout::setHeightMode(HeightMode newHeightMode)
     Q_EMIT heightModeChanged();
 }
 
+ToolBarLayoutStatistics *ToolBarLayout::statistics()
+{
+    if (!d->statistics) {
+        d->statistics = new ToolBarLayoutStatistics(this);
+    }
+    return d->statistics;
+}
+
+ToolBarLayoutStatistics *ToolBarLayout::existingStatistics() const
+{
+    return d->statistics;
+}
+
 void ToolBarLayout::relayout()
 {
     d->implicitSizeValid = false;
@@ -329,11 +462,11 @@ void ToolBarLayout::componentComplete()
 void ToolBarLayout::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
     if (newGeometry != oldGeometry) {
-        if (newGeometry.size() != QSizeF{implicitWidth(), implicitHeight()}) {
-            relayout();
-        } else {
-            polish();
+        // Only which delegates fit depends on the width, what was measured stays valid
+        if (newGeometry.width() != oldGeometry.width()) {
+            d->fitValid = false;
         }
+        polish();
     }
     QQuickItem::geometryChange(newGeometry, oldGeometry);
 }
@@ -381,18 +514,22 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
         return;
     }
 
-    hiddenActions.clear();
-    firstHiddenIndex = -1;
-
-    sortedDelegates = createDelegates();
+    updateSortedDelegates();
 
-    bool ready = std::all_of(delegates.cbegin(), delegates.cend(), [](const std::pair<QObject *const, std::unique_ptr<ToolBarLayoutDelegate>> &entry) {
-        return entry.second->isReady();
+    bool ready = std::all_of(sortedDelegates.cbegin(), sortedDelegates.cend(), [](ToolBarLayoutDelegate *delegate) {
+        return delegate->isReady();
     });
     if (!ready || !moreButtonInstance) {
         return;
     }
 
+    ToolBarLayoutTimer timer(statistics, ToolBarLayoutStatistics::ImplicitSize, "calculateImplicitSize", sortedDelegates.count());
+
+    layoutDelegates.clear();
+    cumulativeWidths.clear();
+    alwaysHiddenActions.clear();
+    hasKeepVisible = false;
+
     qreal maxHeight = 0.0;
     qreal maxWidth = 0.0;
 
@@ -407,29 +544,60 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
 
         if (entry->isHidden()) {
             entry->hide();
-            hiddenActions.append(entry->action());
+            alwaysHiddenActions.append(entry->action());
             continue;
         }
 
-        if (entry->isIconOnly()) {
-            entry->showIcon();
-        } else {
-            entry->showFull();
-        }
+        showPreferred(entry);
+        entry->storeWidths();
+
+        maxWidth += entry->width();
+        layoutDelegates.append(entry);
+        cumulativeWidths.append(maxWidth);
+        maxWidth += spacing;
 
-        maxWidth += entry->width() + spacing;
         maxHeight = std::max(maxHeight, entry->maxHeight());
+        hasKeepVisible = hasKeepVisible || entry->isKeepVisible();
     }
 
     // The last entry also gets spacing but shouldn't, so remove that.
     maxWidth -= spacing;
 
-    visibleActionsWidth = 0.0;
+    delegatesWidth = maxWidth;
+    delegatesHeight = maxHeight;
+    // All of the delegates are shown now
+    fitBreakpoint = layoutDelegates.size();
+
+    implicitSizeValid = true;
+
+    fitDelegates();
+
+    q->polish();
+}
+
+/**
+ * Determine which delegates fit in the current width, from what calculateImplicitSize() measured.
+ *
+ * Without KeepVisible actions, the delegates which fit are simply the ones
+ * ending before the available width, so the breakpoint is found in the
+ * cumulative widths and only the delegates between the previous and the new
+ * breakpoint change.
+ */
+void ToolBarLayoutPrivate::fitDelegates()
+{
+    ToolBarLayoutTimer timer(statistics, ToolBarLayoutStatistics::Fit, "fitDelegates", layoutDelegates.count());
 
-    if (maxWidth > q->width() - (hiddenActions.isEmpty() ? 0.0 : moreButtonInstance->width() + spacing)) {
+    const QList<QObject *> previousHiddenActions = hiddenActions;
+    hiddenActions = alwaysHiddenActions;
+    firstHiddenIndex = -1;
+
+    const qreal width = q->width();
+    int visibleCount = layoutDelegates.size();
+
+    if (delegatesWidth > width - (hiddenActions.isEmpty() ? 0.0 : moreButtonInstance->width() + spacing)) {
         // We have more items than fit into the view, so start hiding some.
 
-        qreal layoutWidth = q->width() - (moreButtonInstance->width() + spacing);
+        qreal layoutWidth = width - (moreButtonInstance->width() + spacing);
         if (alignment & Qt::AlignHCenter) {
             // When centering, we need to reserve space on both sides to make sure
             // things are properly centered, otherwise we will be to the right of
@@ -437,33 +605,75 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
             layoutWidth -= (moreButtonInstance->width() + spacing);
         }
 
-        for (int i = 0; i < sortedDelegates.size(); ++i) {
-            auto delegate = sortedDelegates.at(i);
+        if (hasKeepVisible) {
+            for (auto delegate : std::as_const(layoutDelegates)) {
+                showPreferred(delegate);
+            }
+            hideCandidates.clear();
+            collapseCandidates.clear();
+
+            visibleActionsWidth = 0.0;
+            for (int i = 0; i < layoutDelegates.size(); ++i) {
+                auto delegate = layoutDelegates.at(i);
+
+                maybeHideDelegate(i, visibleActionsWidth, layoutWidth);
+
+                if (delegate->isVisible()) {
+                    visibleActionsWidth += delegate->width() + spacing;
+                    if (delegate->isKeepVisible()) {
+                        collapseCandidates.append(delegate);
+                    } else {
+                        hideCandidates.append(delegate);
+                    }
+                }
+            }
+            if (!qFuzzyIsNull(visibleActionsWidth)) {
+                // Like above, remove spacing on the last element that incorrectly gets spacing added.
+                visibleActionsWidth -= spacing;
+            }
 
-            maybeHideDelegate(i, visibleActionsWidth, layoutWidth);
+            visibleCount = -1;
+            fitBreakpoint = -1;
+        } else {
+            auto breakpoint = std::lower_bound(cumulativeWidths.cbegin(), cumulativeWidths.cend(), layoutWidth);
+            visibleCount = std::distance(cumulativeWidths.cbegin(), breakpoint);
+        }
+    }
 
-            if (delegate->isVisible()) {
-                visibleActionsWidth += delegate->width() + spacing;
+    if (visibleCount >= 0) {
+        const bool changedAll = fitBreakpoint < 0;
+        const int from = changedAll ? 0 : std::min(fitBreakpoint, visibleCount);
+        const int to = changedAll ? layoutDelegates.size() : std::max(fitBreakpoint, visibleCount);
+        for (int i = from; i < to; ++i) {
+            if (i < visibleCount) {
+                showPreferred(layoutDelegates.at(i));
+            } else {
+                layoutDelegates.at(i)->hide();
             }
         }
-        if (!qFuzzyIsNull(visibleActionsWidth)) {
-            // Like above, remove spacing on the last element that incorrectly gets spacing added.
-            visibleActionsWidth -= spacing;
+
+        for (int i = visibleCount; i < layoutDelegates.size(); ++i) {
+            hiddenActions.append(layoutDelegates.at(i)->action());
         }
-    } else {
-        visibleActionsWidth = maxWidth;
+
+        visibleActionsWidth = visibleCount > 0 ? cumulativeWidths.at(visibleCount - 1) : 0.0;
+        fitBreakpoint = visibleCount;
     }
 
+    qreal maxHeight = delegatesHeight;
     if (!hiddenActions.isEmpty()) {
         maxHeight = std::max(maxHeight, moreButtonInstance->implicitHeight());
-    };
-
-    q->setImplicitSize(maxWidth, maxHeight);
-    Q_EMIT q->hiddenActionsChanged();
+    }
 
-    implicitSizeValid = true;
+    q->setImplicitSize(delegatesWidth, maxHeight);
+    if (hiddenActions != previousHiddenActions) {
+        Q_EMIT q->hiddenActionsChanged();
+    }
+    if (statistics) {
+        statistics->setHiddenCount(hiddenActions.count());
+    }
 
-    q->polish();
+    fitValid = true;
 }
 
 void ToolBarLayoutPrivate::performLayout()
@@ -474,19 +684,17 @@ void ToolBarLayoutPrivate::performLayout()
 
     if (!implicitSizeValid) {
         calculateImplicitSize();
+    } else if (!fitValid) {
+        fitDelegates();
     }
 
-    if (sortedDelegates.isEmpty()) {
-        sortedDelegates = createDelegates();
-    }
-
-    bool ready = std::all_of(delegates.cbegin(), delegates.cend(), [](const std::pair<QObject *const, std::unique_ptr<ToolBarLayoutDelegate>> &entry) {
-        return entry.second->isReady();
-    });
-    if (!ready || !moreButtonInstance) {
+    // Only measured once all delegates are ready
+    if (!implicitSizeValid) {
         return;
     }
 
+    ToolBarLayoutTimer timer(statistics, ToolBarLayoutStatistics::Layout, "performLayout", sortedDelegates.count());
+
     qreal width = q->width();
     qreal height = q->height();
 
@@ -564,12 +772,43 @@ void ToolBarLayoutPrivate::performLayout()
         Q_EMIT q->actionsChanged();
         actionsChanged = false;
     }
+}
+
+void ToolBarLayoutPrivate::updateSortedDelegates()
+{
+    if (!sortedDelegatesValid) {
+        sortedDelegates = createDelegates();
+        sortedDelegatesValid = true;
+    }
 
-    sortedDelegates.clear();
+    // Items are created on demand, depending on the current hints of their action
+    for (auto delegate : std::as_const(sortedDelegates)) {
+        delegate->ensureItems();
+    }
+}
+
+void ToolBarLayoutPrivate::removeDelegates()
+{
+    for (auto action : std::as_const(removedActions)) {
+        if (!actions.contains(action)) {
+            delegates.erase(action);
+        }
+    }
+    removedActions.clear();
+    removalTimer->stop();
 }
 
 QList<ToolBarLayoutDelegate *> ToolBarLayoutPrivate::createDelegates()
 {
+    // When other actions replace the removed ones, there is no point in waiting
+    // for the removed ones to come back, their items can be recycled right away.
+    const bool hasNewActions = std::any_of(actions.cbegin(), actions.cend(), [this](QObject *action) {
+        return delegates.find(action) == delegates.end();
+    });
+    if (hasNewActions && !removedActions.isEmpty()) {
+        removeDelegates();
+    }
+
     QList<ToolBarLayoutDelegate *> result;
     for (auto action : std::as_const(actions)) {
         if (delegates.find(action) != delegates.end()) {
@@ -596,6 +835,8 @@ QList<ToolBarLayoutDelegate *> ToolBarLayoutPrivate::createDelegates()
                 moreButtonInstance->setVisible(shouldShowMoreButton);
             });
             QObject::connect(moreButtonInstance, &QQuickItem::widthChanged, q, &ToolBarLayout::minimumWidthChanged);
+            // Which delegates fit depends on the space left by the more button
+            QObject::connect(moreButtonInstance, &QQuickItem::widthChanged, q, &ToolBarLayout::relayout);
             q->relayout();
             Q_EMIT q->minimumWidthChanged();
 
@@ -622,7 +863,7 @@ ToolBarLayoutDelegate *ToolBarLayoutPrivate::createDelegate(QObject *action)
         fullComponent = fullDelegate;
     }
 
-    auto result = new ToolBarLayoutDelegate(q);
+    auto result = new ToolBarLayoutDelegate(q, &delegateWidths);
     result->setAction(action);
     result->createItems(fullComponent, iconDelegate, [this, action](QQuickItem *newItem) {
         newItem->setParentItem(q);
@@ -650,7 +891,7 @@ qreal ToolBarLayoutPrivate::layoutStart(qreal layoutWidth)
 
 void ToolBarLayoutPrivate::maybeHideDelegate(int index, qreal &currentWidth, qreal totalWidth)
 {
-    auto delegate = sortedDelegates.at(index);
+    auto delegate = layoutDelegates.at(index);
 
     if (!delegate->isVisible()) {
         // If the delegate isn't visible anyway, do nothing.
@@ -671,11 +912,11 @@ void ToolBarLayoutPrivate::maybeHideDelegate(int index, qreal &currentWidth, qre
         // delegate.
         if (currentWidth + delegate->iconWidth() > totalWidth) {
             // First, hide any earlier actions that are not marked as KeepVisible.
-            for (auto currentIndex = index - 1; currentIndex >= 0; --currentIndex) {
-                auto previousDelegate = sortedDelegates.at(currentIndex);
-                if (!previousDelegate->isVisible() || previousDelegate->isKeepVisible()) {
-                    continue;
-                }
+            // The candidates are only the visible ones, so each earlier action
+            // is looked at once for the whole layout rather than for every
+            // KeepVisible action that doesn't fit.
+            while (!hideCandidates.isEmpty()) {
+                auto previousDelegate = hideCandidates.takeLast();
 
                 auto width = previousDelegate->width();
                 previousDelegate->hide();
@@ -697,11 +938,8 @@ void ToolBarLayoutPrivate::maybeHideDelegate(int index, qreal &currentWidth, qre
 
             // Hiding normal actions did not help enough, so go through actions
             // with KeepVisible set and try and collapse them to IconOnly.
-            for (auto currentIndex = index - 1; currentIndex >= 0; --currentIndex) {
-                auto previousDelegate = sortedDelegates.at(currentIndex);
-                if (!previousDelegate->isVisible() || !previousDelegate->isKeepVisible()) {
-                    continue;
-                }
+            while (!collapseCandidates.isEmpty()) {
+                auto previousDelegate = collapseCandidates.takeLast();
 
                 auto extraSpace = previousDelegate->width() - previousDelegate->iconWidth();
                 previousDelegate->showIcon();
@@ -738,6 +976,15 @@ void ToolBarLayoutPrivate::maybeHideDelegate(int index, qreal &currentWidth, qre
     }
 }
 
+void ToolBarLayoutPrivate::showPreferred(ToolBarLayoutDelegate *delegate)
+{
+    if (delegate->isIconOnly()) {
+        delegate->showIcon();
+    } else {
+        delegate->showFull();
+    }
+}
+
 void ToolBarLayoutPrivate::appendAction(ToolBarLayout::ActionsProperty *list, QObject *action)
 {
     auto layout = reinterpret_cast<ToolBarLayout *>(list->data);
@@ -7,9 +7,12 @@
 #ifndef TOOLBARLAYOUT_H
 #define TOOLBARLAYOUT_H
 
+#include <QPointer>
 #include <QQuickItem>
 #include <memory>
 
+#include "layoutstatistics.h"
+
 class ToolBarLayoutPrivate;
 
 /**
@@ -20,16 +23,106 @@ class ToolBarLayoutAttached : public QObject
     Q_OBJECT
     /**
      * The action this delegate was created for.
+     *
+     * Delegates are recycled when their action is removed, so this can change
+     * to another action during the lifetime of a delegate.
      */
-    Q_PROPERTY(QObject *action READ action CONSTANT FINAL)
+    Q_PROPERTY(QObject *action READ action NOTIFY actionChanged FINAL)
 public:
     ToolBarLayoutAttached(QObject *parent = nullptr);
 
     QObject *action() const;
     void setAction(QObject *action);
+    Q_SIGNAL void actionChanged();
 
 private:
-    QObject *m_action = nullptr;
+    QPointer<QObject> m_action;
+};
+
+/**
+ * Tells which toolbars make resizing a window slow: how often a ToolBarLayout measured,
+ * fitted and positioned its delegates, and how long that took in milliseconds.
+ *
+ * Fitting happens as part of calculating the implicit size, so its time is also included there.
+ * The layout starts measuring when this object is first accessed, and logs the same
+ * measures on kf.lingmoui.layouts.toolbarlayout when its debug output is enabled.
+ * @see ToolBarLayout::statistics
+ * @since 6.5
+ */
+class ToolBarLayoutStatistics : public LayoutStatistics
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+
+    /**
+     * How many times the delegates have been measured to calculate the implicit size, and the time it took.
+     */
+    Q_PROPERTY(int implicitSizeCount READ implicitSizeCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal implicitSizeTime READ implicitSizeTime NOTIFY changed FINAL)
+
+    /**
+     * How many times the layout worked out which delegates fit its width, and the time it took.
+     */
+    Q_PROPERTY(int fitCount READ fitCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal fitTime READ fitTime NOTIFY changed FINAL)
+
+    /**
+     * How many times the delegates have been positioned, and the time it took.
+     */
+    Q_PROPERTY(int layoutCount READ layoutCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal layoutTime READ layoutTime NOTIFY changed FINAL)
+
+    /**
+     * How many delegate items have been created, and the time from starting to
+     * finishing their creation. As delegates are created asynchronously, this
+     * spans several frames and includes the time spent on other things meanwhile.
+     */
+    Q_PROPERTY(int incubationCount READ incubationCount NOTIFY changed FINAL)
+    Q_PROPERTY(qreal incubationTime READ incubationTime NOTIFY changed FINAL)
+
+    /**
+     * How many delegate items have been reused from the items of removed delegates
+     * rather than created.
+     */
+    Q_PROPERTY(int recycledCount READ recycledCount NOTIFY changed FINAL)
+
+    /**
+     * How many delegates the last fit hid, because they didn't fit or their action is always hidden.
+     */
+    Q_PROPERTY(int hiddenCount READ hiddenCount NOTIFY changed FINAL)
+
+public:
+    enum Operation {
+        ImplicitSize,
+        Fit,
+        Layout,
+        Incubation,
+        OperationCount,
+    };
+
+    ToolBarLayoutStatistics(QObject *parent = nullptr);
+    ~ToolBarLayoutStatistics() override;
+
+    int implicitSizeCount() const;
+    qreal implicitSizeTime() const;
+    int fitCount() const;
+    qreal fitTime() const;
+    int layoutCount() const;
+    qreal layoutTime() const;
+    int incubationCount() const;
+    qreal incubationTime() const;
+    int recycledCount() const;
+    int hiddenCount() const;
+
+    void recordRecycled();
+    void setHiddenCount(int count);
+
+    void reset() override;
+
+private:
+    int m_recycledCount = 0;
+    int m_hiddenCount = 0;
 };
 
 /**
@@ -37,9 +130,10 @@ private:
  *
  * This effectively combines RowLayout and Repeater in a single item, with the
  * addition of some extra performance enhancing tweaks. It will create instances
- * of ::fullDelegate and ::itemDelegate for each action in ::actions . These are
- * then positioned horizontally. Any action that ends up being placed outside
- * the width of the item is hidden and will be part of ::hiddenActions.
+ * of ::fullDelegate and ::itemDelegate for each action in ::actions , only once
+ * the action can be displayed that way. These are then positioned
+ * horizontally. Any action that ends up being placed outside the width of the
+ * item is hidden and will be part of ::hiddenActions.
  *
  * The items created as delegates are always created asynchronously, to avoid
  * creation lag spikes. Each delegate has access to the action it was created
@@ -131,6 +225,12 @@ class ToolBarLayout : public QQuickItem
      * \sa HeightMode
      */
     Q_PROPERTY(HeightMode heightMode READ heightMode WRITE setHeightMode NOTIFY heightModeChanged FINAL)
+    /**
+     * Counters of the time the layout spends measuring, fitting and creating its delegates, for profiling.
+     * @see ToolBarLayoutStatistics
+     * @since 6.5
+     */
+    Q_PROPERTY(ToolBarLayoutStatistics *statistics READ statistics CONSTANT FINAL)
 
 public:
     using ActionsProperty = QQmlListProperty<QObject>;
@@ -205,6 +305,8 @@ public:
     void setHeightMode(HeightMode newHeightMode);
     Q_SIGNAL void heightModeChanged();
 
+    ToolBarLayoutStatistics *statistics();
+
     /**
      * Queue a relayout of this layout.
      *
@@ -225,6 +327,10 @@ protected:
 
 private:
     friend class ToolBarLayoutPrivate;
+    friend class ToolBarLayoutDelegate;
+    // Only set once statistics() has been called
+    ToolBarLayoutStatistics *existingStatistics() const;
+
     const std::unique_ptr<ToolBarLayoutPrivate> d;
 };
 
@@ -6,8 +6,11 @@
 
 #include "toolbarlayoutdelegate.h"
 
+#include <QQmlComponent>
+
 #include "loggingcategory.h"
 #include "toolbarlayout.h"
+#include "toolbarlayoutlogging.h"
 
 ToolBarDelegateIncubator::ToolBarDelegateIncubator(QQmlComponent *component, QQmlContext *context)
     : QQmlIncubator(QQmlIncubator::Asynchronous)
@@ -28,6 +31,7 @@ void ToolBarDelegateIncubator::setCompletedCallback(std::function<void(ToolBarDe
 
 void ToolBarDelegateIncubator::create()
 {
+    m_timer.start();
     m_component->create(*this, m_context);
 }
 
@@ -36,6 +40,11 @@ bool ToolBarDelegateIncubator::isFinished()
     return m_finished;
 }
 
+qint64 ToolBarDelegateIncubator::nsecsElapsed() const
+{
+    return m_timer.nsecsElapsed();
+}
+
 void ToolBarDelegateIncubator::setInitialState(QObject *object)
 {
     auto item = qobject_cast<QQuickItem *>(object);
@@ -61,9 +70,99 @@ void ToolBarDelegateIncubator::statusChanged(QQmlIncubator::Status status)
     }
 }
 
-ToolBarLayoutDelegate::ToolBarLayoutDelegate(ToolBarLayout *parent)
+ToolBarDelegatePool::ToolBarDelegatePool(QQmlComponent *component)
+    : QObject(component)
+{
+    m_expiryTimer.setSingleShot(true);
+    m_expiryTimer.setInterval(ExpiryInterval);
+    connect(&m_expiryTimer, &QTimer::timeout, this, &ToolBarDelegatePool::clear);
+}
+
+ToolBarDelegatePool::~ToolBarDelegatePool()
+{
+    clear();
+}
+
+void ToolBarDelegatePool::clear()
+{
+    for (const auto &item : std::as_const(m_items)) {
+        delete item.data();
+    }
+    m_items.clear();
+}
+
+QQuickItem *ToolBarDelegatePool::take(QQmlComponent *component)
+{
+    auto pool = component->findChild<ToolBarDelegatePool *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!pool) {
+        return nullptr;
+    }
+
+    while (!pool->m_items.isEmpty()) {
+        if (QQuickItem *item = pool->m_items.takeLast()) {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+void ToolBarDelegatePool::release(QQmlComponent *component, QQuickItem *item)
+{
+    auto pool = component ? component->findChild<ToolBarDelegatePool *>(QString(), Qt::FindDirectChildrenOnly) : nullptr;
+    if (!pool && component) {
+        pool = new ToolBarDelegatePool(component);
+    }
+
+    if (!pool || pool->m_items.count() >= MaximumItems) {
+        delete item;
+        return;
+    }
+
+    item->setVisible(false);
+    item->setParentItem(nullptr);
+    pool->m_items.append(item);
+    pool->m_expiryTimer.start();
+}
+
+bool ToolBarDelegateWidths::contains(QObject *action, Mode mode) const
+{
+    auto it = m_widths.constFind(Key{action, mode});
+    return it != m_widths.cend() && it->text == text(action);
+}
+
+qreal ToolBarDelegateWidths::width(QObject *action, Mode mode) const
+{
+    auto it = m_widths.constFind(Key{action, mode});
+    return it != m_widths.cend() && it->text == text(action) ? it->width : 0.0;
+}
+
+void ToolBarDelegateWidths::setWidth(QObject *action, Mode mode, qreal width)
+{
+    m_widths.insert(Key{action, mode}, Width{text(action), width});
+}
+
+void ToolBarDelegateWidths::remove(QObject *action)
+{
+    m_widths.removeIf([action](const QHash<Key, Width>::iterator &it) {
+        return it.key().action == action;
+    });
+}
+
+void ToolBarDelegateWidths::clear()
+{
+    m_widths.clear();
+}
+
+QString ToolBarDelegateWidths::text(QObject *action)
+{
+    // The text is what changes the width of a given delegate the most
+    return action->property("text").toString();
+}
+
+ToolBarLayoutDelegate::ToolBarLayoutDelegate(ToolBarLayout *parent, ToolBarDelegateWidths *widths)
     : QObject() // Note: delegates are managed by unique_ptr, so don't parent
     , m_parent(parent)
+    , m_widths(widths)
 {
 }
 
@@ -79,11 +178,11 @@ ToolBarLayoutDelegate::~ToolBarLayoutDelegate()
     }
     if (m_full) {
         m_full->disconnect(this);
-        delete m_full;
+        ToolBarDelegatePool::release(m_fullComponent, m_full);
     }
     if (m_icon) {
         m_icon->disconnect(this);
-        delete m_icon;
+        ToolBarDelegatePool::release(m_iconComponent, m_icon);
     }
 }
 
@@ -119,35 +218,41 @@ void ToolBarLayoutDelegate::setAction(QObject *action)
 
 void ToolBarLayoutDelegate::createItems(QQmlComponent *fullComponent, QQmlComponent *iconComponent, std::function<void(QQuickItem *)> callback)
 {
-    m_fullIncubator = new ToolBarDelegateIncubator(fullComponent, qmlContext(fullComponent));
-    m_fullIncubator->setStateCallback(callback);
-    m_fullIncubator->setCompletedCallback([this](ToolBarDelegateIncubator *incubator) {
-        if (incubator->isError()) {
-            qCWarning(LingmoUILayoutsLog) << "Could not create delegate for ToolBarLayout";
-            const auto errors = incubator->errors();
-            for (const auto &error : errors) {
-                qCWarning(LingmoUILayoutsLog) << error;
-            }
-            return;
-        }
+    // Only one of the two items is shown at a time, so they are only created
+    // once the layout needs them, see ensureItems().
+    m_fullComponent = fullComponent;
+    m_iconComponent = iconComponent;
+    m_itemCallback = callback;
+}
 
-        m_full = qobject_cast<QQuickItem *>(incubator->object());
-        m_full->setVisible(false);
-        connect(m_full, &QQuickItem::implicitWidthChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
-        connect(m_full, &QQuickItem::implicitHeightChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
-        connect(m_full, &QQuickItem::visibleChanged, this, &ToolBarLayoutDelegate::ensureItemVisibility);
+void ToolBarLayoutDelegate::ensureItems()
+{
+    if (needsFull() && !m_full && !m_fullIncubator) {
+        createItem(m_fullComponent, ToolBarDelegateWidths::Full, m_fullIncubator, m_full);
+    }
+    if (needsIcon() && !m_icon && !m_iconIncubator) {
+        createItem(m_iconComponent, ToolBarDelegateWidths::Icon, m_iconIncubator, m_icon);
+    }
+}
 
-        if (m_icon) {
-            m_ready = true;
-        }
+void ToolBarLayoutDelegate::createItem(QQmlComponent *component, ToolBarDelegateWidths::Mode mode, ToolBarDelegateIncubator *&itemIncubator, QQuickItem *&item)
+{
+    // Rebinding an item left by a removed delegate is much cheaper than creating one.
+    // There is no need to relayout either, as this happens while laying out.
+    if (QQuickItem *recycled = ToolBarDelegatePool::take(component)) {
+        m_itemCallback(recycled);
+        setupItem(recycled, item);
 
-        m_parent->relayout();
+        if (auto statistics = m_parent->existingStatistics()) {
+            statistics->recordRecycled();
+        }
+        qCDebug(LingmoUIToolBarLayoutLog) << "Recycled delegate item for" << m_action;
+        return;
+    }
 
-        QMetaObject::invokeMethod(this, &ToolBarLayoutDelegate::cleanupIncubators, Qt::QueuedConnection);
-    });
-    m_iconIncubator = new ToolBarDelegateIncubator(iconComponent, qmlContext(iconComponent));
-    m_iconIncubator->setStateCallback(callback);
-    m_iconIncubator->setCompletedCallback([this](ToolBarDelegateIncubator *incubator) {
+    itemIncubator = new ToolBarDelegateIncubator(component, qmlContext(component));
+    itemIncubator->setStateCallback(m_itemCallback);
+    itemIncubator->setCompletedCallback([this, mode, &item](ToolBarDelegateIncubator *incubator) {
         if (incubator->isError()) {
             qCWarning(LingmoUILayoutsLog) << "Could not create delegate for ToolBarLayout";
             const auto errors = incubator->errors();
@@ -157,28 +262,41 @@ void ToolBarLayoutDelegate::createItems(QQmlComponent *fullComponent, QQmlCompon
             return;
         }
 
-        m_icon = qobject_cast<QQuickItem *>(incubator->object());
-        m_icon->setVisible(false);
-        connect(m_icon, &QQuickItem::implicitWidthChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
-        connect(m_icon, &QQuickItem::implicitHeightChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
-        connect(m_icon, &QQuickItem::visibleChanged, this, &ToolBarLayoutDelegate::ensureItemVisibility);
+        setupItem(qobject_cast<QQuickItem *>(incubator->object()), item);
 
-        if (m_full) {
-            m_ready = true;
+        const qint64 elapsed = incubator->nsecsElapsed();
+        if (auto statistics = m_parent->existingStatistics()) {
+            statistics->record(ToolBarLayoutStatistics::Incubation, elapsed);
+        }
+        qCDebug(LingmoUIToolBarLayoutLog).nospace() << "Creating delegate item for " << m_action << " took " << elapsed / 1000 << "us";
+
+        // If the layout predicted the item right, it only needs to place it
+        const bool predicted = m_widths->contains(m_action, mode) && qFuzzyIsNull(m_widths->width(m_action, mode) - item->width())
+            && item->implicitHeight() <= m_parent->implicitHeight();
+        if (predicted) {
+            m_parent->polish();
+        } else {
+            m_parent->relayout();
         }
-
-        m_parent->relayout();
 
         QMetaObject::invokeMethod(this, &ToolBarLayoutDelegate::cleanupIncubators, Qt::QueuedConnection);
     });
+    itemIncubator->create();
+}
 
-    m_fullIncubator->create();
-    m_iconIncubator->create();
+void ToolBarLayoutDelegate::setupItem(QQuickItem *newItem, QQuickItem *&item)
+{
+    item = newItem;
+    item->setVisible(false);
+    connect(item, &QQuickItem::implicitWidthChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
+    connect(item, &QQuickItem::implicitHeightChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
+    connect(item, &QQuickItem::visibleChanged, this, &ToolBarLayoutDelegate::ensureItemVisibility);
 }
 
 bool ToolBarLayoutDelegate::isReady() const
 {
-    return m_ready;
+    // Items still being created don't hold the layout back if their width is known
+    return (!needsFull() || m_full || hasFullWidth()) && (!needsIcon() || m_icon || hasIconWidth());
 }
 
 bool ToolBarLayoutDelegate::isActionVisible() const
@@ -232,69 +350,91 @@ void ToolBarLayoutDelegate::show()
 
 void ToolBarLayoutDelegate::setPosition(qreal x, qreal y)
 {
-    m_full->setX(x);
-    m_icon->setX(x);
-    m_full->setY(y);
-    m_icon->setY(y);
+    if (m_full) {
+        m_full->setX(x);
+        m_full->setY(y);
+    }
+    if (m_icon) {
+        m_icon->setX(x);
+        m_icon->setY(y);
+    }
 }
 
 void ToolBarLayoutDelegate::setHeight(qreal height)
 {
-    m_full->setHeight(height);
-    m_icon->setHeight(height);
+    if (m_full) {
+        m_full->setHeight(height);
+    }
+    if (m_icon) {
+        m_icon->setHeight(height);
+    }
 }
 
 void ToolBarLayoutDelegate::resetHeight()
 {
-    m_full->resetHeight();
-    m_icon->resetHeight();
+    if (m_full) {
+        m_full->resetHeight();
+    }
+    if (m_icon) {
+        m_icon->resetHeight();
+    }
 }
 
 qreal ToolBarLayoutDelegate::width() const
 {
     if (m_iconVisible) {
-        return m_icon->width();
+        return iconWidth();
     }
-    return m_full->width();
+    return fullWidth();
 }
 
 qreal ToolBarLayoutDelegate::height() const
 {
-    if (m_iconVisible) {
-        return m_icon->height();
-    }
-    return m_full->height();
+    QQuickItem *item = m_iconVisible ? m_icon : m_full;
+    return item ? item->height() : 0.0;
 }
 
 qreal ToolBarLayoutDelegate::implicitWidth() const
 {
-    if (m_iconVisible) {
-        return m_icon->implicitWidth();
-    }
-    return m_full->implicitWidth();
+    QQuickItem *item = m_iconVisible ? m_icon : m_full;
+    return item ? item->implicitWidth() : width();
 }
 
 qreal ToolBarLayoutDelegate::implicitHeight() const
 {
-    if (m_iconVisible) {
-        return m_icon->implicitHeight();
-    }
-    return m_full->implicitHeight();
+    QQuickItem *item = m_iconVisible ? m_icon : m_full;
+    return item ? item->implicitHeight() : 0.0;
 }
 
 qreal ToolBarLayoutDelegate::maxHeight() const
 {
-    return std::max(m_full->implicitHeight(), m_icon->implicitHeight());
+    return std::max(m_full ? m_full->implicitHeight() : 0.0, m_icon ? m_icon->implicitHeight() : 0.0);
 }
 
 qreal ToolBarLayoutDelegate::iconWidth() const
 {
-    return m_icon->width();
+    if (m_icon) {
+        return m_icon->width();
+    }
+    return m_widths->width(m_action, ToolBarDelegateWidths::Icon);
 }
 
 qreal ToolBarLayoutDelegate::fullWidth() const
 {
-    return m_full->width();
+    if (m_full) {
+        return m_full->width();
+    }
+    return m_widths->width(m_action, ToolBarDelegateWidths::Full);
+}
+
+void ToolBarLayoutDelegate::storeWidths()
+{
+    if (m_full) {
+        m_widths->setWidth(m_action, ToolBarDelegateWidths::Full, m_full->width());
+    }
+    if (m_icon) {
+        m_widths->setWidth(m_action, ToolBarDelegateWidths::Icon, m_icon->width());
+    }
 }
 
 void ToolBarLayoutDelegate::actionVisibleChanged()
@@ -309,6 +449,27 @@ void ToolBarLayoutDelegate::displayHintChanged()
     m_parent->relayout();
 }
 
+bool ToolBarLayoutDelegate::needsFull() const
+{
+    // KeepVisible actions may switch between the two items when space runs out
+    return m_actionVisible && !isHidden() && (!isIconOnly() || isKeepVisible());
+}
+
+bool ToolBarLayoutDelegate::needsIcon() const
+{
+    return m_actionVisible && !isHidden() && (isIconOnly() || isKeepVisible());
+}
+
+bool ToolBarLayoutDelegate::hasFullWidth() const
+{
+    return m_widths->contains(m_action, ToolBarDelegateWidths::Full);
+}
+
+bool ToolBarLayoutDelegate::hasIconWidth() const
+{
+    return m_widths->contains(m_action, ToolBarDelegateWidths::Icon);
+}
+
 void ToolBarLayoutDelegate::cleanupIncubators()
 {
     if (m_fullIncubator && m_fullIncubator->isFinished()) {
@@ -8,8 +8,12 @@
 #define TOOLBARLAYOUTDELEGATE_H
 
 #include "displayhint.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
 #include <QQmlIncubator>
 #include <QQuickItem>
+#include <QTimer>
 
 class ToolBarLayout;
 
@@ -28,6 +32,8 @@ public:
     void create();
 
     bool isFinished();
+    // Time since create() was called
+    qint64 nsecsElapsed() const;
 
 private:
     void setInitialState(QObject *object) override;
@@ -38,6 +44,91 @@ private:
     std::function<void(QQuickItem *)> m_stateCallback;
     std::function<void(ToolBarDelegateIncubator *)> m_completedCallback;
     bool m_finished = false;
+    QElapsedTimer m_timer;
+};
+
+/*
+ * Items of delegates which are no longer used, to be reused by new delegates
+ * rather than creating new items.
+ *
+ * There is one pool per component, as a child of it, and the items are destroyed
+ * along with it. Items keep the bindings of the context they were created in, so
+ * they can't be shared with layouts whose delegates come from another component:
+ * ActionToolBar declares its delegates inline, which makes every instance use its
+ * own components and pool. Only layouts sharing the same component objects share
+ * their items.
+ *
+ * Pooled items still refer to the actions they were last bound to, so they are
+ * dropped when nothing took them for a while.
+ */
+class ToolBarDelegatePool : public QObject
+{
+    Q_OBJECT
+public:
+    ~ToolBarDelegatePool() override;
+
+    static QQuickItem *take(QQmlComponent *component);
+    static void release(QQmlComponent *component, QQuickItem *item);
+
+private:
+    explicit ToolBarDelegatePool(QQmlComponent *component);
+
+    void clear();
+
+    // Enough for swapping the actions of a typical toolbar without keeping too much around
+    static constexpr int MaximumItems = 32;
+    // In milliseconds, long enough for the actions being replaced in a few steps
+    static constexpr int ExpiryInterval = 10000;
+
+    QList<QPointer<QQuickItem>> m_items;
+    QTimer m_expiryTimer;
+};
+
+/*
+ * Widths of the delegate items of a ToolBarLayout, as last measured for each
+ * action and display mode.
+ *
+ * While the item of a delegate is being created, the layout uses these to
+ * predict its width rather than waiting for it, so that it doesn't need to be
+ * laid out again once the item is there, unless its width actually changed.
+ * A width is only valid for the action text it was measured with, and only the
+ * last one is kept, so actions whose text keeps changing don't grow the cache.
+ */
+class ToolBarDelegateWidths
+{
+public:
+    enum Mode {
+        Full,
+        Icon,
+    };
+
+    bool contains(QObject *action, Mode mode) const;
+    qreal width(QObject *action, Mode mode) const;
+    void setWidth(QObject *action, Mode mode, qreal width);
+    void remove(QObject *action);
+    void clear();
+
+private:
+    struct Key {
+        QObject *action;
+        Mode mode;
+
+        bool operator==(const Key &other) const
+        {
+            return action == other.action && mode == other.mode;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.action, int(key.mode));
+        }
+    };
+    struct Width {
+        QString text;
+        qreal width = 0.0;
+    };
+    static QString text(QObject *action);
+
+    QHash<Key, Width> m_widths;
 };
 
 /*
@@ -49,12 +140,13 @@ class ToolBarLayoutDelegate : public QObject
 {
     Q_OBJECT
 public:
-    ToolBarLayoutDelegate(ToolBarLayout *parent);
+    ToolBarLayoutDelegate(ToolBarLayout *parent, ToolBarDelegateWidths *widths);
     ~ToolBarLayoutDelegate() override;
 
     QObject *action() const;
     void setAction(QObject *action);
     void createItems(QQmlComponent *fullComponent, QQmlComponent *iconComponent, std::function<void(QQuickItem *)> callback);
+    void ensureItems();
 
     bool isReady() const;
     bool isActionVisible() const;
@@ -81,6 +173,9 @@ public:
     qreal iconWidth() const;
     qreal fullWidth() const;
 
+    // Remembers the widths of the items which exist, see ToolBarDelegateWidths
+    void storeWidths();
+
 private:
     Q_SLOT void actionVisibleChanged();
     Q_SLOT void displayHintChanged();
@@ -93,18 +188,27 @@ private:
             m_icon->setVisible(m_iconVisible);
         }
     }
+    bool needsFull() const;
+    bool needsIcon() const;
+    bool hasFullWidth() const;
+    bool hasIconWidth() const;
+    void createItem(QQmlComponent *component, ToolBarDelegateWidths::Mode mode, ToolBarDelegateIncubator *&itemIncubator, QQuickItem *&item);
+    void setupItem(QQuickItem *newItem, QQuickItem *&item);
     void cleanupIncubators();
     void triggerRelayout();
 
     ToolBarLayout *m_parent = nullptr;
+    ToolBarDelegateWidths *m_widths = nullptr;
     QObject *m_action = nullptr;
     QQuickItem *m_full = nullptr;
     QQuickItem *m_icon = nullptr;
     ToolBarDelegateIncubator *m_fullIncubator = nullptr;
     ToolBarDelegateIncubator *m_iconIncubator = nullptr;
+    QPointer<QQmlComponent> m_fullComponent;
+    QPointer<QQmlComponent> m_iconComponent;
+    std::function<void(QQuickItem *)> m_itemCallback;
 
     DisplayHint::DisplayHints m_displayHint = DisplayHint::NoPreference;
-    bool m_ready = false;
     bool m_actionVisible = true;
     bool m_fullVisible = false;
     bool m_iconVisible = false;
@@ -10,17 +10,62 @@
 #include <QQmlComponent>
 #include <QQmlContext>
 #include <QQmlEngine>
+#include <QQmlIncubator>
 #include <QQmlProperty>
+#include <QQuickWindow>
 
 #include "loggingcategory.h"
 
+#include <algorithm>
+#include <functional>
+
+class PagePoolIncubator : public QQmlIncubator
+{
+public:
+    PagePoolIncubator(std::function<void(QQmlIncubator::Status)> callback)
+        : QQmlIncubator(QQmlIncubator::Asynchronous)
+        , m_callback(std::move(callback))
+    {
+    }
+
+protected:
+    void statusChanged(QQmlIncubator::Status status) override
+    {
+        m_callback(status);
+    }
+
+private:
+    std::function<void(QQmlIncubator::Status)> m_callback;
+};
+
 PagePool::PagePool(QObject *parent)
     : QObject(parent)
 {
+    m_preloadTimer.setInterval(50);
+    connect(&m_preloadTimer, &QTimer::timeout, this, &PagePool::preloadStep);
 }
 
 PagePool::~PagePool()
 {
+    for (PendingPage *pending : std::as_const(m_pendingPages)) {
+        delete pending->incubator;
+        if (m_componentForUrl.value(pending->url) != pending->component) {
+            delete pending->component;
+        }
+        delete pending;
+    }
+    for (PendingPage *preload : std::as_const(m_preloads)) {
+        delete preload->incubator;
+        if (m_componentForUrl.value(preload->url) != preload->component) {
+            delete preload->component;
+        }
+        delete preload;
+    }
+    for (PendingPage *pending : std::as_const(m_finishedPages)) {
+        delete pending->incubator;
+        delete pending;
+    }
+    qDeleteAll(m_componentForUrl);
 }
 
 QUrl PagePool::lastLoadedUrl() const
@@ -62,6 +107,122 @@ bool PagePool::cachePages() const
     return m_cachePages;
 }
 
+int PagePool::maximumPages() const
+{
+    return m_maximumPages;
+}
+
+void PagePool::setMaximumPages(int pages)
+{
+    pages = std::max(0, pages);
+    if (pages == m_maximumPages) {
+        return;
+    }
+
+    m_maximumPages = pages;
+    Q_EMIT maximumPagesChanged();
+
+    evictPages();
+}
+
+int PagePool::maximumCost() const
+{
+    return m_maximumCost;
+}
+
+void PagePool::setMaximumCost(int cost)
+{
+    cost = std::max(0, cost);
+    if (cost == m_maximumCost) {
+        return;
+    }
+
+    m_maximumCost = cost;
+    Q_EMIT maximumCostChanged();
+
+    evictPages();
+}
+
+int PagePool::totalCost() const
+{
+    return m_totalCost;
+}
+
+bool PagePool::cacheComponents() const
+{
+    return m_cacheComponents;
+}
+
+void PagePool::setCacheComponents(bool cache)
+{
+    if (cache == m_cacheComponents) {
+        return;
+    }
+
+    m_cacheComponents = cache;
+    Q_EMIT cacheComponentsChanged();
+
+    evictComponents();
+}
+
+int PagePool::maximumComponents() const
+{
+    return m_maximumComponents;
+}
+
+void PagePool::setMaximumComponents(int components)
+{
+    components = std::max(0, components);
+    if (components == m_maximumComponents) {
+        return;
+    }
+
+    m_maximumComponents = components;
+    Q_EMIT maximumComponentsChanged();
+
+    evictComponents();
+}
+
+int PagePool::componentCount() const
+{
+    return m_componentForUrl.count();
+}
+
+bool PagePool::isLoading() const
+{
+    return !m_pendingPages.isEmpty();
+}
+
+qreal PagePool::loadingProgress() const
+{
+    if (m_pendingPages.isEmpty()) {
+        return 0;
+    }
+
+    // Incubation doesn't tell how far it got, count it as a whole
+    qreal progress = 0;
+    for (const PendingPage *pending : std::as_const(m_pendingPages)) {
+        progress += pending->incubator ? 0.5 : pending->component->progress() * 0.5;
+    }
+    return progress / m_pendingPages.count();
+}
+
+int PagePool::preloadInterval() const
+{
+    return m_preloadTimer.interval();
+}
+
+void PagePool::setPreloadInterval(int msecs)
+{
+    msecs = std::max(1, msecs);
+    if (msecs == m_preloadTimer.interval()) {
+        return;
+    }
+
+    m_preloadTimer.setInterval(msecs);
+    Q_EMIT preloadIntervalChanged();
+}
+
 QQuickItem *PagePool::loadPage(const QString &url, QJSValue callback)
 {
     return loadPageWithProperties(url, QVariantMap(), callback);
@@ -73,11 +234,14 @@ QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantM
     Q_ASSERT(engine);
 
     const QUrl actualUrl = resolvedUrl(url);
+    // Take over what a preload got done
+    settlePreload(actualUrl, true);
 
     auto found = m_itemForUrl.find(actualUrl);
     if (found != m_itemForUrl.end()) {
         m_lastLoadedUrl = found.key();
         m_lastLoadedItem = found.value();
+        touchPage(found.key());
 
         if (callback.isCallable()) {
             QJSValueList args = {engine->newQObject(found.value())};
@@ -120,11 +284,7 @@ QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantM
                 callback.call(args);
             }
 
-            if (m_cachePages) {
-                component->deleteLater();
-            } else {
-                m_componentForUrl[component->url()] = component;
-            }
+            cacheComponent(component->url(), component);
         });
 
         return nullptr;
@@ -139,31 +299,399 @@ QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantM
         return nullptr;
     }
 
+    storePage(actualUrl, component, item);
+
+    if (callback.isCallable()) {
+        QJSValueList args = {engine->newQObject(item)};
+        callback.call(args);
+        // We could return the item, but for api coherence return null
+        return nullptr;
+    }
+    return item;
+}
+
+void PagePool::loadPageAsync(const QString &url, const QVariantMap &properties, QJSValue callback)
+{
+    const auto engine = qmlEngine(this);
+    Q_ASSERT(engine);
+
+    const QUrl actualUrl = resolvedUrl(url);
+    settlePreload(actualUrl, true);
+
+    if (QQuickItem *item = m_itemForUrl.value(actualUrl)) {
+        m_lastLoadedUrl = actualUrl;
+        m_lastLoadedItem = item;
+        touchPage(actualUrl);
+        Q_EMIT lastLoadedUrlChanged();
+        Q_EMIT lastLoadedItemChanged();
+
+        if (callback.isCallable()) {
+            QJSValueList args = {engine->newQObject(item)};
+            callback.call(args);
+        }
+        Q_EMIT pageReady(actualUrl, item);
+        return;
+    }
+
+    // There is only one instance per url when caching pages
+    if (m_cachePages) {
+        for (PendingPage *pending : std::as_const(m_pendingPages)) {
+            if (pending->url == actualUrl) {
+                if (callback.isCallable()) {
+                    pending->callbacks << callback;
+                }
+                return;
+            }
+        }
+    }
+
+    const bool wasLoading = isLoading();
+
+    auto pending = new PendingPage;
+    pending->url = actualUrl;
+    pending->properties = properties;
+    if (callback.isCallable()) {
+        pending->callbacks << callback;
+    }
+    pending->component = m_componentForUrl.value(actualUrl);
+    if (!pending->component) {
+        pending->component = new QQmlComponent(engine, actualUrl, QQmlComponent::Asynchronous);
+    }
+    m_pendingPages << pending;
+
+    if (pending->component->isLoading()) {
+        connect(pending->component, &QQmlComponent::progressChanged, this, &PagePool::loadingProgressChanged);
+        connect(
+            pending->component,
+            &QQmlComponent::statusChanged,
+            this,
+            [this, pending]() {
+                if (m_pendingPages.contains(pending)) {
+                    startIncubation(pending);
+                }
+            },
+            Qt::SingleShotConnection);
+    } else {
+        startIncubation(pending);
+    }
+
+    notifyLoading(wasLoading);
+}
+
+void PagePool::startIncubation(PendingPage *pending)
+{
+    if (!pending->component->isReady()) {
+        qCWarning(LingmoUILog) << pending->component->errors();
+        abortIncubation(pending);
+        return;
+    }
+
+    pending->incubator = new PagePoolIncubator([this, pending](QQmlIncubator::Status status) {
+        if (!m_pendingPages.contains(pending)) {
+            return;
+        }
+        if (status == QQmlIncubator::Ready) {
+            finishIncubation(pending);
+        } else if (status == QQmlIncubator::Error) {
+            qCWarning(LingmoUILog) << pending->incubator->errors();
+            abortIncubation(pending);
+        }
+    });
+    pending->incubator->setInitialProperties(pending->properties);
+    ensureIncubationController();
+    pending->component->create(*pending->incubator, qmlContext(this));
+
+    // Creation may have ended already
+    if (m_pendingPages.contains(pending)) {
+        Q_EMIT loadingProgressChanged();
+    }
+}
+
+void PagePool::finishIncubation(PendingPage *pending)
+{
+    const auto engine = qmlEngine(this);
+    QObject *object = pending->incubator->object();
+    auto item = qobject_cast<QQuickItem *>(object);
+    if (!item) {
+        qCWarning(LingmoUILog) << "Storing Non-QQuickItem in PagePool not supported";
+        object->deleteLater();
+        abortIncubation(pending);
+        return;
+    }
+
+    const bool wasLoading = isLoading();
+    retirePendingPage(pending);
+    storePage(pending->url, pending->component, item);
+
+    for (QJSValue &callback : pending->callbacks) {
+        QJSValueList args = {engine->newQObject(item)};
+        callback.call(args);
+    }
+    Q_EMIT pageReady(pending->url, item);
+
+    notifyLoading(wasLoading);
+}
+
+void PagePool::abortIncubation(PendingPage *pending)
+{
+    const bool wasLoading = isLoading();
+    retirePendingPage(pending);
+    releaseComponent(pending->component);
+
+    notifyLoading(wasLoading);
+}
+
+void PagePool::retirePendingPage(PendingPage *pending)
+{
+    m_pendingPages.removeOne(pending);
+    m_preloads.removeOne(pending);
+    if (pending->component) {
+        disconnect(pending->component, nullptr, this, nullptr);
+    }
+
+    m_finishedPages << pending;
+    if (m_finishedPages.count() == 1) {
+        QMetaObject::invokeMethod(
+            this,
+            [this]() {
+                for (PendingPage *pending : std::as_const(m_finishedPages)) {
+                    delete pending->incubator;
+                    delete pending;
+                }
+                m_finishedPages.clear();
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+QQuickWindow *PagePool::window() const
+{
+    // PagePool isn't an item, use the window of the item it's declared in
+    for (QObject *object = parent(); object; object = object->parent()) {
+        if (auto item = qobject_cast<QQuickItem *>(object)) {
+            return item->window();
+        }
+        if (auto window = qobject_cast<QQuickWindow *>(object)) {
+            return window;
+        }
+    }
+    return nullptr;
+}
+
+bool PagePool::ensureIncubationController()
+{
+    // Without a controller asynchronous incubators run synchronously. QQuickView installs
+    // the one of its window, QQmlApplicationEngine doesn't: do what QQuickView does.
+    QQmlEngine *engine = qmlEngine(this);
+    if (!engine->incubationController()) {
+        if (QQuickWindow *window = this->window()) {
+            engine->setIncubationController(window->incubationController());
+        }
+    }
+    return engine->incubationController();
+}
+
+void PagePool::notifyLoading(bool wasLoading)
+{
+    if (wasLoading != isLoading()) {
+        Q_EMIT loadingChanged();
+    }
+    Q_EMIT loadingProgressChanged();
+}
+
+void PagePool::storePage(const QUrl &url, QQmlComponent *component, QQuickItem *item)
+{
+    cacheComponent(url, component);
+
     if (m_cachePages) {
-        component->deleteLater();
         QQmlEngine::setObjectOwnership(item, QQmlEngine::CppOwnership);
-        m_itemForUrl[component->url()] = item;
-        m_urlForItem[item] = component->url();
+        addPage(url, item);
         Q_EMIT itemsChanged();
         Q_EMIT urlsChanged();
 
     } else {
-        m_componentForUrl[component->url()] = component;
         QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
     }
 
-    m_lastLoadedUrl = actualUrl;
+    m_lastLoadedUrl = url;
     m_lastLoadedItem = item;
     Q_EMIT lastLoadedUrlChanged();
     Q_EMIT lastLoadedItemChanged();
 
-    if (callback.isCallable()) {
-        QJSValueList args = {engine->newQObject(item)};
-        callback.call(args);
-        // We could return the item, but for api coherence return null
-        return nullptr;
+    // Now that the new page is the last loaded one it won't be evicted itself
+    if (m_cachePages) {
+        evictPages();
+    }
+}
+
+void PagePool::preload(const QString &url, int priority, bool createPage)
+{
+    const QUrl actualUrl = resolvedUrl(url);
+    if (m_itemForUrl.contains(actualUrl)) {
+        return;
+    }
+    for (const PendingPage *pending : std::as_const(m_pendingPages)) {
+        if (pending->url == actualUrl) {
+            return;
+        }
+    }
+
+    PendingPage *preload = nullptr;
+    auto it = std::find_if(m_preloads.begin(), m_preloads.end(), [&actualUrl](const PendingPage *preload) {
+        return preload->url == actualUrl;
+    });
+    if (it != m_preloads.end()) {
+        preload = *it;
+        m_preloads.erase(it);
+        preload->createPage = preload->createPage || createPage;
+    } else {
+        preload = new PendingPage;
+        preload->url = actualUrl;
+        preload->createPage = createPage;
+    }
+    preload->priority = priority;
+
+    // After the preloads of the same priority
+    auto position = std::find_if(m_preloads.begin(), m_preloads.end(), [priority](const PendingPage *other) {
+        return other->priority < priority;
+    });
+    m_preloads.insert(position, preload);
+
+    watchFrames();
+    if (!m_preloadTimer.isActive()) {
+        m_preloadTimer.start();
+    }
+}
+
+void PagePool::watchFrames()
+{
+    QQuickWindow *window = this->window();
+    if (window == m_preloadWindow) {
+        return;
+    }
+    if (m_preloadWindow) {
+        disconnect(m_preloadWindow, &QQuickWindow::frameSwapped, this, nullptr);
+    }
+    m_preloadWindow = window;
+    if (window) {
+        // Emitted from the render thread with the threaded render loop
+        connect(window, &QQuickWindow::frameSwapped, this, [this]() {
+            m_frameSwapped = true;
+        });
+    }
+}
+
+void PagePool::cancelPreload(const QString &url)
+{
+    settlePreload(resolvedUrl(url), false);
+}
+
+void PagePool::preloadStep()
+{
+    if (m_preloads.isEmpty()) {
+        m_preloadTimer.stop();
+        return;
+    }
+    // Pages which have actually been asked for go first, and frames being rendered mean an animation or some input going on
+    const bool frameSwapped = std::exchange(m_frameSwapped, false);
+    if (!m_pendingPages.isEmpty() || frameSwapped) {
+        return;
+    }
+
+    const auto engine = qmlEngine(this);
+    PendingPage *preload = m_preloads.first();
+
+    if (!preload->component) {
+        preload->component = m_componentForUrl.value(preload->url);
+    }
+    if (!preload->component) {
+        // The engine compiles it in its loader thread, the next steps only check on it
+        preload->component = new QQmlComponent(engine, preload->url, QQmlComponent::Asynchronous);
+    }
+    if (preload->component->isLoading()) {
+        return;
+    }
+    if (!preload->component->isReady()) {
+        qCWarning(LingmoUILog) << preload->component->errors();
+        settlePreload(preload->url, false);
+        return;
+    }
+
+    // Without a controller the page would be created in one go, which is no longer preloading in the background
+    if (!preload->createPage || !m_cachePages || m_itemForUrl.contains(preload->url) || !ensureIncubationController()) {
+        settlePreload(preload->url, true);
+        return;
+    }
+
+    if (preload->incubator) {
+        // The window is still incubating it
+        return;
+    }
+
+    preload->incubator = new PagePoolIncubator([this, preload](QQmlIncubator::Status status) {
+        if (!m_preloads.contains(preload)) {
+            return;
+        }
+        if (status == QQmlIncubator::Ready) {
+            finishPreload(preload);
+        } else if (status == QQmlIncubator::Error) {
+            qCWarning(LingmoUILog) << preload->incubator->errors();
+            retirePendingPage(preload);
+            releaseComponent(preload->component);
+        }
+    });
+    // The window's controller takes it from there, a slice after each frame
+    preload->component->create(*preload->incubator, qmlContext(this));
+}
+
+void PagePool::finishPreload(PendingPage *preload)
+{
+    QObject *object = preload->incubator->object();
+    auto item = qobject_cast<QQuickItem *>(object);
+
+    retirePendingPage(preload);
+    cacheComponent(preload->url, preload->component);
+
+    if (!item || !m_cachePages) {
+        if (!item) {
+            qCWarning(LingmoUILog) << "Storing Non-QQuickItem in PagePool not supported";
+        }
+        object->deleteLater();
+        return;
+    }
+
+    // Unlike a loaded page, a preloaded one doesn't become the last loaded item
+    QQmlEngine::setObjectOwnership(item, QQmlEngine::CppOwnership);
+    addPage(preload->url, item);
+    Q_EMIT itemsChanged();
+    Q_EMIT urlsChanged();
+
+    evictPages();
+}
+
+void PagePool::settlePreload(const QUrl &url, bool keepComponent)
+{
+    auto it = std::find_if(m_preloads.begin(), m_preloads.end(), [&url](const PendingPage *preload) {
+        return preload->url == url;
+    });
+    if (it == m_preloads.end()) {
+        return;
+    }
+
+    PendingPage *preload = *it;
+    if (preload->incubator) {
+        preload->incubator->clear();
+    }
+    retirePendingPage(preload);
+
+    if (preload->component) {
+        // A compiled component spares the compilation to whoever loads the page next
+        if (keepComponent) {
+            cacheComponent(url, preload->component);
+        } else {
+            releaseComponent(preload->component);
+        }
     }
-    return item;
 }
 
 QQuickItem *PagePool::createFromComponent(QQmlComponent *component, const QVariantMap &properties)
@@ -191,6 +719,149 @@ QQuickItem *PagePool::createFromComponent(QQmlComponent *component, const QVaria
     return item;
 }
 
+void PagePool::addPage(const QUrl &url, QQuickItem *item)
+{
+    // Rough estimate of the memory the page takes, every object of the page counts the same
+    const int cost = item->findChildren<QObject *>().count() + 1;
+
+    m_itemForUrl[url] = item;
+    m_urlForItem[item] = url;
+    m_costForItem[item] = cost;
+    m_recentUrls.append(url);
+    m_totalCost += cost;
+    Q_EMIT totalCostChanged();
+
+    connect(item, &QObject::destroyed, this, [this, item]() {
+        if (m_urlForItem.contains(item)) {
+            forgetPage(item);
+            Q_EMIT itemsChanged();
+            Q_EMIT urlsChanged();
+        }
+    });
+    // A page removed from its PageRow may be the one to evict
+    connect(item, &QQuickItem::parentChanged, this, &PagePool::queueEviction);
+}
+
+void PagePool::forgetPage(QQuickItem *item)
+{
+    const QUrl url = m_urlForItem.take(item);
+    m_itemForUrl.remove(url);
+    m_recentUrls.removeOne(url);
+    m_totalCost -= m_costForItem.take(item);
+    disconnect(item, nullptr, this, nullptr);
+    Q_EMIT totalCostChanged();
+}
+
+void PagePool::touchPage(const QUrl &url)
+{
+    m_recentUrls.removeOne(url);
+    m_recentUrls.append(url);
+}
+
+void PagePool::evictPages()
+{
+    const auto overBudget = [this]() {
+        return (m_maximumPages > 0 && m_itemForUrl.count() > m_maximumPages) || (m_maximumCost > 0 && m_totalCost > m_maximumCost);
+    };
+
+    bool evicted = false;
+    int i = 0;
+    while (i < m_recentUrls.count() && overBudget()) {
+        const QUrl url = m_recentUrls.at(i);
+        QQuickItem *item = m_itemForUrl.value(url);
+
+        // Pages which are shown somewhere, such as in a PageRow, are still in use
+        if (!item || item->parentItem() || item == m_lastLoadedItem) {
+            ++i;
+            continue;
+        }
+
+        forgetPage(item);
+        evicted = true;
+        Q_EMIT pageEvicted(url, item);
+        item->deleteLater();
+    }
+
+    if (evicted) {
+        Q_EMIT itemsChanged();
+        Q_EMIT urlsChanged();
+    }
+}
+
+void PagePool::queueEviction()
+{
+    if (m_evictionQueued || (m_maximumPages == 0 && m_maximumCost == 0)) {
+        return;
+    }
+
+    // Let whoever reparented the page finish with it first
+    m_evictionQueued = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            m_evictionQueued = false;
+            evictPages();
+        },
+        Qt::QueuedConnection);
+}
+
+void PagePool::cacheComponent(const QUrl &url, QQmlComponent *component)
+{
+    QQmlComponent *cached = m_componentForUrl.value(url);
+    if (cached) {
+        m_recentComponentUrls.removeOne(url);
+        m_recentComponentUrls << url;
+        if (cached != component) {
+            releaseComponent(component);
+        }
+        return;
+    }
+
+    if (!m_cacheComponents || !component->isReady()) {
+        releaseComponent(component);
+        return;
+    }
+
+    m_componentForUrl.insert(url, component);
+    m_recentComponentUrls << url;
+    evictComponents();
+    Q_EMIT componentCountChanged();
+}
+
+void PagePool::releaseComponent(QQmlComponent *component)
+{
+    if (std::find(m_componentForUrl.cbegin(), m_componentForUrl.cend(), component) != m_componentForUrl.cend()) {
+        return;
+    }
+    // Pages still being loaded from it will release it when done
+    for (const QList<PendingPage *> &pages : {m_pendingPages, m_preloads}) {
+        for (const PendingPage *pending : pages) {
+            if (pending->component == component) {
+                return;
+            }
+        }
+    }
+
+    component->deleteLater();
+}
+
+void PagePool::evictComponents()
+{
+    const int maximum = m_cacheComponents ? m_maximumComponents : 0;
+    if (m_cacheComponents && maximum == 0) {
+        return;
+    }
+
+    const int count = m_componentForUrl.count();
+    while (m_recentComponentUrls.count() > maximum) {
+        releaseComponent(m_componentForUrl.take(m_recentComponentUrls.takeFirst()));
+    }
+
+    if (count != m_componentForUrl.count()) {
+        Q_EMIT componentCountChanged();
+    }
+}
+
 QUrl PagePool::resolvedUrl(const QString &stringUrl) const
 {
     const auto ctx = qmlContext(this);
@@ -263,8 +934,7 @@ void PagePool::deletePage(const QVariant &page)
         return;
     }
 
-    m_itemForUrl.remove(url);
-    m_urlForItem.remove(item);
+    forgetPage(item);
     item->deleteLater();
 
     Q_EMIT itemsChanged();
@@ -273,12 +943,27 @@ void PagePool::deletePage(const QVariant &page)
 
 void PagePool::clear()
 {
+    // Pages still being created go as well
+    const auto pendingPages = m_pendingPages;
+    for (PendingPage *pending : pendingPages) {
+        if (pending->incubator) {
+            pending->incubator->clear();
+        }
+        abortIncubation(pending);
+    }
+    const auto preloads = m_preloads;
+    for (PendingPage *preload : preloads) {
+        settlePreload(preload->url, false);
+    }
+
     for (const auto &component : std::as_const(m_componentForUrl)) {
         component->deleteLater();
     }
     m_componentForUrl.clear();
+    m_recentComponentUrls.clear();
 
     for (const auto &item : std::as_const(m_itemForUrl)) {
+        disconnect(item, nullptr, this, nullptr);
         // items that had been deparented are safe to delete
         if (!item->parentItem()) {
             item->deleteLater();
@@ -287,6 +972,9 @@ void PagePool::clear()
     }
     m_itemForUrl.clear();
     m_urlForItem.clear();
+    m_costForItem.clear();
+    m_recentUrls.clear();
+    m_totalCost = 0;
     m_lastLoadedUrl = QUrl();
     m_lastLoadedItem = nullptr;
 
@@ -294,6 +982,8 @@ void PagePool::clear()
     Q_EMIT lastLoadedItemChanged();
     Q_EMIT itemsChanged();
     Q_EMIT urlsChanged();
+    Q_EMIT totalCostChanged();
+    Q_EMIT componentCountChanged();
 }
 
 #include "moc_pagepool.cpp"
@@ -8,6 +8,9 @@
 #include <QObject>
 #include <QPointer>
 #include <QQuickItem>
+#include <QTimer>
+
+class PagePoolIncubator;
 
 /**
  * A Pool of Page items, pages will be unique per url and the items
@@ -51,11 +54,87 @@ class PagePool : public QObject
      * If true (default) the pages will be kept around, will have C++ ownership and
      * only one instance per page will be created.
      * If false the pages will have Javascript ownership (thus deleted on pop by the
-     * page stacks) and each call to loadPage will create a new page instance. When
-     * cachePages is false, Components get cached nevertheless.
+     * page stacks) and each call to loadPage will create a new page instance.
+     * Compiled Components are cached independently, see cacheComponents.
      */
     Q_PROPERTY(bool cachePages READ cachePages WRITE setCachePages NOTIFY cachePagesChanged FINAL)
 
+    /**
+     * The maximum number of pages kept around when cachePages is true.
+     * When there are more, the least recently loaded ones are destroyed, emitting pageEvicted() first.
+     * Pages which are shown, i.e. which have a parent item such as a PageRow, and the last loaded page
+     * are never evicted, so the pool can temporarily hold more pages than this.
+     * 0 (default) means no limit.
+     * @since 6.5
+     */
+    Q_PROPERTY(int maximumPages READ maximumPages WRITE setMaximumPages NOTIFY maximumPagesChanged FINAL)
+
+    /**
+     * The maximum total cost of the pages kept around when cachePages is true, with the same
+     * eviction rules as maximumPages.
+     * The cost of a page approximates the memory it uses with the number of objects it is made of,
+     * counted when it is created.
+     * 0 (default) means no limit.
+     * @see totalCost
+     * @since 6.5
+     */
+    Q_PROPERTY(int maximumCost READ maximumCost WRITE setMaximumCost NOTIFY maximumCostChanged FINAL)
+
+    /**
+     * The cost of all the pages currently in the pool.
+     * @see maximumCost
+     * @since 6.5
+     */
+    Q_PROPERTY(int totalCost READ totalCost NOTIFY totalCostChanged FINAL)
+
+    /**
+     * If true (default) the Components compiled from the QML files of the pages are kept around,
+     * whether the pages themselves are cached or not, so loading a page again, for instance
+     * after it has been evicted, skips loading and compiling its file.
+     * Components are much cheaper than the pages created from them.
+     * @see maximumComponents
+     * @since 6.5
+     */
+    Q_PROPERTY(bool cacheComponents READ cacheComponents WRITE setCacheComponents NOTIFY cacheComponentsChanged FINAL)
+
+    /**
+     * The maximum number of Components kept around when cacheComponents is true.
+     * When there are more, the least recently used ones are dropped.
+     * 0 means no limit, which lets the cache grow with every page ever loaded. default: 16
+     * @since 6.5
+     */
+    Q_PROPERTY(int maximumComponents READ maximumComponents WRITE setMaximumComponents NOTIFY maximumComponentsChanged FINAL)
+
+    /**
+     * The number of Components currently cached.
+     * @see cacheComponents
+     * @since 6.5
+     */
+    Q_PROPERTY(int componentCount READ componentCount NOTIFY componentCountChanged FINAL)
+
+    /**
+     * True while pages requested with loadPageAsync() are being loaded or created.
+     * @since 6.5
+     */
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged FINAL)
+
+    /**
+     * Approximate progress of the pages requested with loadPageAsync(), from 0 to 1.
+     * The first half covers loading and compiling their QML files, the second one creating them.
+     * @since 6.5
+     */
+    Q_PROPERTY(qreal loadingProgress READ loadingProgress NOTIFY loadingProgressChanged FINAL)
+
+    /**
+     * The interval, in milliseconds, between two preloading steps, see preload().
+     * A step only happens when the pool is idle: no page requested with loadPageAsync()
+     * is being loaded and the window hasn't rendered any frame since the previous step.
+     * Each step starts at most one piece of work, so this bounds the time spent preloading.
+     * default: 50
+     * @since 6.5
+     */
+    Q_PROPERTY(int preloadInterval READ preloadInterval WRITE setPreloadInterval NOTIFY preloadIntervalChanged FINAL)
+
 public:
     PagePool(QObject *parent = nullptr);
     ~PagePool() override;
@@ -68,6 +147,28 @@ public:
     void setCachePages(bool cache);
     bool cachePages() const;
 
+    int maximumPages() const;
+    void setMaximumPages(int pages);
+
+    int maximumCost() const;
+    void setMaximumCost(int cost);
+
+    int totalCost() const;
+
+    bool cacheComponents() const;
+    void setCacheComponents(bool cache);
+
+    int maximumComponents() const;
+    void setMaximumComponents(int components);
+
+    int componentCount() const;
+
+    bool isLoading() const;
+    qreal loadingProgress() const;
+
+    int preloadInterval() const;
+    void setPreloadInterval(int msecs);
+
     /**
      * Returns the instance of the item defined in the QML file identified
      * by url, only one instance will be made per url if cachePAges is true.
@@ -89,6 +190,54 @@ public:
 
     Q_INVOKABLE QQuickItem *loadPageWithProperties(const QString &url, const QVariantMap &properties, QJSValue callback = QJSValue());
 
+    /**
+     * Loads the page defined in the QML file identified by url without blocking:
+     * the file is compiled in the background and the page is created a bit
+     * at each frame, in the time the window has left after rendering it.
+     * If the engine has no incubation controller, as with QQmlApplicationEngine,
+     * the one of the window the pool is declared in is installed, like QQuickView does.
+     * A pool outside of any window can't incubate: the page is then created before
+     * this returns, and callback is called right away.
+     * Meanwhile the application stays responsive, for instance to show a placeholder
+     * bound to loading and loadingProgress.
+     *
+     * The same caching rules as loadPage() apply. When the page is ready, it becomes
+     * the lastLoadedItem, callback is called with it and pageReady() is emitted.
+     *
+     * @param url full url of the item, as in loadPage()
+     * @param properties the initial properties of the page
+     * @param callback called with the page once it is ready
+     * @since 6.5
+     */
+    Q_INVOKABLE void loadPageAsync(const QString &url, const QVariantMap &properties = QVariantMap(), QJSValue callback = QJSValue());
+
+    /**
+     * Prepares in the background a page which is likely to be loaded soon, such as the
+     * details of the selected item of a list, so that loading it afterwards is quick.
+     *
+     * The QML file is compiled and, if createPage is true and cachePages is true as well,
+     * the page is created and added to the pool, without becoming the lastLoadedItem.
+     * The work is spread in steps taken every preloadInterval milliseconds, and only
+     * while the application is idle. The page is then incubated by the window the pool
+     * is declared in, in the time it has left after rendering each frame. A pool outside
+     * of any window can't do that, so it only compiles the file.
+     * Preloading a page again only updates its priority.
+     *
+     * @param url full url of the item, as in loadPage()
+     * @param priority pages with a higher priority are preloaded first
+     * @param createPage whether to also create the page, or only compile its file
+     * @see cancelPreload()
+     * @since 6.5
+     */
+    Q_INVOKABLE void preload(const QString &url, int priority = 0, bool createPage = false);
+
+    /**
+     * Stops preloading the page identified by url, if it isn't ready yet.
+     * @see preload()
+     * @since 6.5
+     */
+    Q_INVOKABLE void cancelPreload(const QString &url);
+
     /**
      * @returns The url of the page for the given instance, empty if there is no correspondence
      */
@@ -133,15 +282,96 @@ Q_SIGNALS:
     void itemsChanged();
     void urlsChanged();
     void cachePagesChanged();
+    void maximumPagesChanged();
+    void maximumCostChanged();
+    void totalCostChanged();
+    void cacheComponentsChanged();
+    void maximumComponentsChanged();
+    void componentCountChanged();
+
+    /**
+     * Emitted right before a page is destroyed to stay within maximumPages and maximumCost,
+     * for instance to save its state.
+     * @param url the url the page was loaded from
+     * @param page the page, which gets deleted once the control returns to the event loop
+     * @since 6.5
+     */
+    void pageEvicted(const QUrl &url, QQuickItem *page);
+
+    void loadingChanged();
+    void loadingProgressChanged();
+    void preloadIntervalChanged();
+
+    /**
+     * Emitted when a page requested with loadPageAsync() is ready
+     * @param url the url the page was loaded from
+     * @param page the new page
+     * @since 6.5
+     */
+    void pageReady(const QUrl &url, QQuickItem *page);
 
 private:
+    // A page requested with loadPageAsync() or preload() which isn't ready yet
+    struct PendingPage {
+        QUrl url;
+        QVariantMap properties;
+        QList<QJSValue> callbacks;
+        QQmlComponent *component = nullptr;
+        PagePoolIncubator *incubator = nullptr;
+        // Only used by preloads
+        int priority = 0;
+        bool createPage = false;
+    };
+
+    void startIncubation(PendingPage *pending);
+    void finishIncubation(PendingPage *pending);
+    void abortIncubation(PendingPage *pending);
+    void retirePendingPage(PendingPage *pending);
+    QQuickWindow *window() const;
+    bool ensureIncubationController();
+    void notifyLoading(bool wasLoading);
+    void storePage(const QUrl &url, QQmlComponent *component, QQuickItem *item);
+    void preloadStep();
+    void watchFrames();
+    void finishPreload(PendingPage *preload);
+    void settlePreload(const QUrl &url, bool keepComponent);
+
     QQuickItem *createFromComponent(QQmlComponent *component, const QVariantMap &properties);
+    void addPage(const QUrl &url, QQuickItem *item);
+    void forgetPage(QQuickItem *item);
+    void touchPage(const QUrl &url);
+    void evictPages();
+    void queueEviction();
+    void cacheComponent(const QUrl &url, QQmlComponent *component);
+    void releaseComponent(QQmlComponent *component);
+    void evictComponents();
 
     QUrl m_lastLoadedUrl;
     QPointer<QQuickItem> m_lastLoadedItem;
     QHash<QUrl, QQuickItem *> m_itemForUrl;
     QHash<QUrl, QQmlComponent *> m_componentForUrl;
     QHash<QQuickItem *, QUrl> m_urlForItem;
+    QHash<QQuickItem *, int> m_costForItem;
+    // Urls of the cached pages, the least recently loaded first
+    QList<QUrl> m_recentUrls;
+    // Urls of the cached components, the least recently used first
+    QList<QUrl> m_recentComponentUrls;
+
+    int m_maximumPages = 0;
+    int m_maximumCost = 0;
+    int m_totalCost = 0;
+    bool m_cacheComponents = true;
+    int m_maximumComponents = 16;
+    QList<PendingPage *> m_pendingPages;
+    // Incubators can't be deleted from their own notifications, finished pages wait here for the next event loop iteration
+    QList<PendingPage *> m_finishedPages;
+    // Pages to preload, the highest priority first
+    QList<PendingPage *> m_preloads;
+    QTimer m_preloadTimer;
+    // Preloading waits for the window to stop rendering frames
+    QPointer<QQuickWindow> m_preloadWindow;
+    bool m_frameSwapped = false;
 
     bool m_cachePages = true;
+    bool m_evictionQueued = false;
 };
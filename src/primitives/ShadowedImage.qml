@@ -130,17 +130,26 @@ Item {
     Image {
         id: image
         anchors.fill: parent
+
+        // A stretched image covers the item exactly, so its texture can be
+        // sampled directly, which keeps small images in the shared texture
+        // atlas. Other fill modes need to be rendered to a separate texture.
+        readonly property bool sampledDirectly: fillMode === Image.Stretch
+
+        // Use opacity rather than visible so the image keeps updating its
+        // texture provider.
+        opacity: sampledDirectly && !shadowRectangle.softwareRendering ? 0 : 1
     }
 
     ShaderEffectSource {
         id: textureSource
-        sourceItem: image
+        sourceItem: image.sampledDirectly ? null : image
         hideSource: !shadowRectangle.softwareRendering
     }
 
     LingmoUI.ShadowedTexture {
         id: shadowRectangle
         anchors.fill: parent
-        source: (image.status === Image.Ready && !softwareRendering) ? textureSource : null
+        source: (image.status === Image.Ready && !softwareRendering) ? (image.sampledDirectly ? image : textureSource) : null
     }
 }
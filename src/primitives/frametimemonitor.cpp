@@ -0,0 +1,126 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "frametimemonitor.h"
+
+#include <QQuickWindow>
+#include <QScreen>
+
+// Fraction of the frame budget above which a frame counts as slow.
+static constexpr double slowFrameThreshold = 0.8;
+// Fraction of the frame budget below which a frame counts as fast.
+static constexpr double fastFrameThreshold = 0.4;
+// Consecutive slow frames needed before quality is reduced.
+static constexpr int slowFramesToReduce = 30;
+// Consecutive fast frames needed before quality is restored. This is
+// intentionally a lot larger than slowFramesToReduce to avoid flip-flopping.
+static constexpr int fastFramesToRestore = 180;
+// Time without any frame, in milliseconds, after which quality is restored.
+static constexpr int idleTimeToRestore = 1000;
+// Weight of the most recent frame in the moving average.
+static constexpr double averageWeight = 0.1;
+
+FrameTimeMonitor *FrameTimeMonitor::forWindow(QQuickWindow *window)
+{
+    if (!window) {
+        return nullptr;
+    }
+
+    auto monitor = window->findChild<FrameTimeMonitor *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!monitor) {
+        monitor = new FrameTimeMonitor(window);
+    }
+    return monitor;
+}
+
+FrameTimeMonitor::FrameTimeMonitor(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+{
+    // These are emitted on the render thread when using the threaded render
+    // loop, so use direct connections to measure there.
+    connect(
+        window,
+        &QQuickWindow::beforeSynchronizing,
+        this,
+        [this]() {
+            m_frameTimer.start();
+        },
+        Qt::DirectConnection);
+    connect(
+        window,
+        &QQuickWindow::afterRendering,
+        this,
+        [this]() {
+            if (m_frameTimer.isValid()) {
+                m_lastFrameTime.store(m_frameTimer.nsecsElapsed(), std::memory_order_relaxed);
+            }
+        },
+        Qt::DirectConnection);
+
+    // Evaluation happens on the GUI thread.
+    connect(window, &QQuickWindow::frameSwapped, this, &FrameTimeMonitor::evaluateFrame, Qt::QueuedConnection);
+
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(idleTimeToRestore);
+    connect(&m_idleTimer, &QTimer::timeout, this, &FrameTimeMonitor::restoreQuality);
+}
+
+bool FrameTimeMonitor::isQualityReduced() const
+{
+    return m_qualityReduced;
+}
+
+void FrameTimeMonitor::evaluateFrame()
+{
+    const auto frameTime = m_lastFrameTime.load(std::memory_order_relaxed);
+
+    m_averageFrameTime = m_averageFrameTime * (1.0 - averageWeight) + frameTime * averageWeight;
+
+    const qreal refreshRate = m_window->screen() ? m_window->screen()->refreshRate() : 60.0;
+    const double budget = 1'000'000'000.0 / (refreshRate > 0.0 ? refreshRate : 60.0);
+
+    if (m_averageFrameTime > budget * slowFrameThreshold) {
+        m_slowFrames++;
+        m_fastFrames = 0;
+    } else if (m_averageFrameTime < budget * fastFrameThreshold) {
+        m_fastFrames++;
+        m_slowFrames = 0;
+    } else {
+        m_slowFrames = 0;
+        m_fastFrames = 0;
+    }
+
+    if (!m_qualityReduced && m_slowFrames >= slowFramesToReduce) {
+        m_qualityReduced = true;
+        m_slowFrames = 0;
+        Q_EMIT qualityReducedChanged();
+    } else if (m_qualityReduced && m_fastFrames >= fastFramesToRestore) {
+        restoreQuality();
+    }
+
+    // Every frame pushes the idle restoration back
+    if (m_qualityReduced) {
+        m_idleTimer.start();
+    }
+}
+
+void FrameTimeMonitor::restoreQuality()
+{
+    m_idleTimer.stop();
+    if (!m_qualityReduced) {
+        return;
+    }
+
+    // Whatever made the frames slow is over, start measuring afresh
+    m_qualityReduced = false;
+    m_averageFrameTime = 0.0;
+    m_slowFrames = 0;
+    m_fastFrames = 0;
+    Q_EMIT qualityReducedChanged();
+}
+
+#include "moc_frametimemonitor.cpp"
@@ -0,0 +1,57 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <atomic>
+
+class QQuickWindow;
+
+/**
+ * Watches the time a window spends synchronizing and rendering each frame.
+ *
+ * When the window repeatedly exceeds its frame budget, the monitor switches
+ * to reduced quality, which items using ShadowedRectangle::RenderType::Adaptive
+ * react to by using cheaper shaders. Once the frame time drops well below the
+ * budget for a while, or once the window stops rendering for a moment, full quality
+ * is restored.
+ *
+ * There is one monitor per window, use forWindow() to get it.
+ */
+class FrameTimeMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static FrameTimeMonitor *forWindow(QQuickWindow *window);
+
+    bool isQualityReduced() const;
+    Q_SIGNAL void qualityReducedChanged();
+
+private:
+    explicit FrameTimeMonitor(QQuickWindow *window);
+
+    void evaluateFrame();
+    void restoreQuality();
+
+    QQuickWindow *m_window = nullptr;
+
+    // Only used on the render thread.
+    QElapsedTimer m_frameTimer;
+    // Written on the render thread, read on the GUI thread.
+    std::atomic<qint64> m_lastFrameTime = 0;
+
+    double m_averageFrameTime = 0.0;
+    int m_slowFrames = 0;
+    int m_fastFrames = 0;
+    bool m_qualityReduced = false;
+    // An idle window renders no fast frames to restore quality with
+    QTimer m_idleTimer;
+};
@@ -0,0 +1,141 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "renderstatistics.h"
+
+#include <QMetaMethod>
+
+#include <algorithm>
+
+std::atomic<qint64> RenderStatistics::s_materialUploads = 0;
+std::atomic<qint64> RenderStatistics::s_geometryUploads = 0;
+std::atomic<qint64> RenderStatistics::s_nodesCreated = 0;
+
+RenderStatistics::RenderStatistics(QObject *parent)
+    : QObject(parent)
+    , m_lastNodesCreated(nodesCreated())
+{
+    // Only runs while somebody listens to the counters, see connectNotify()
+    m_sampleTimer.setInterval(1000);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &RenderStatistics::sample);
+    m_sampleClock.start();
+}
+
+qint64 RenderStatistics::materialUploads()
+{
+    return s_materialUploads.load(std::memory_order_relaxed);
+}
+
+void RenderStatistics::addMaterialUpload()
+{
+    s_materialUploads.fetch_add(1, std::memory_order_relaxed);
+}
+
+qint64 RenderStatistics::geometryUploads()
+{
+    return s_geometryUploads.load(std::memory_order_relaxed);
+}
+
+void RenderStatistics::addGeometryUpload()
+{
+    s_geometryUploads.fetch_add(1, std::memory_order_relaxed);
+}
+
+qint64 RenderStatistics::nodesCreated()
+{
+    return s_nodesCreated.load(std::memory_order_relaxed);
+}
+
+void RenderStatistics::addNodeCreated()
+{
+    s_nodesCreated.fetch_add(1, std::memory_order_relaxed);
+}
+
+qint64 RenderStatistics::nodesCreatedPerSecond() const
+{
+    return m_nodesCreatedPerSecond;
+}
+
+void RenderStatistics::reset()
+{
+    s_materialUploads.store(0, std::memory_order_relaxed);
+    s_geometryUploads.store(0, std::memory_order_relaxed);
+    s_nodesCreated.store(0, std::memory_order_relaxed);
+    m_lastNodesCreated = 0;
+    m_sampleClock.start();
+
+    m_notifiedMaterialUploads = 0;
+    m_notifiedGeometryUploads = 0;
+    m_notifiedNodesCreated = 0;
+    Q_EMIT changed();
+}
+
+void RenderStatistics::connectNotify(const QMetaMethod &signal)
+{
+    if (isSampled(signal) && m_listeners++ == 0) {
+        // Measure from now on, rather than over the time nobody was listening
+        m_lastNodesCreated = nodesCreated();
+        m_sampleClock.start();
+        m_sampleTimer.start();
+    }
+    QObject::connectNotify(signal);
+}
+
+void RenderStatistics::disconnectNotify(const QMetaMethod &signal)
+{
+    // An invalid signal means all connections went at once
+    if ((!signal.isValid() || isSampled(signal)) && m_listeners > 0) {
+        m_listeners = signal.isValid() ? m_listeners - 1 : 0;
+        if (m_listeners == 0) {
+            m_sampleTimer.stop();
+        }
+    }
+    QObject::disconnectNotify(signal);
+}
+
+bool RenderStatistics::isSampled(const QMetaMethod &signal) const
+{
+    return signal == QMetaMethod::fromSignal(&RenderStatistics::nodesCreatedPerSecondChanged) || signal == QMetaMethod::fromSignal(&RenderStatistics::changed);
+}
+
+void RenderStatistics::sample()
+{
+    if (updateRate()) {
+        Q_EMIT nodesCreatedPerSecondChanged();
+    }
+
+    const qint64 material = materialUploads();
+    const qint64 geometry = geometryUploads();
+    const qint64 nodes = nodesCreated();
+    if (material != m_notifiedMaterialUploads || geometry != m_notifiedGeometryUploads || nodes != m_notifiedNodesCreated) {
+        m_notifiedMaterialUploads = material;
+        m_notifiedGeometryUploads = geometry;
+        m_notifiedNodesCreated = nodes;
+        Q_EMIT changed();
+    }
+}
+
+bool RenderStatistics::updateRate()
+{
+    // Too short a period gives a meaningless rate, keep the previous one
+    const qint64 elapsed = m_sampleClock.elapsed();
+    if (elapsed < 1000) {
+        return false;
+    }
+
+    const auto created = nodesCreated();
+    const auto perSecond = std::max(created - m_lastNodesCreated, qint64(0)) * 1000 / elapsed;
+    m_lastNodesCreated = created;
+    m_sampleClock.start();
+
+    if (perSecond == m_nodesCreatedPerSecond) {
+        return false;
+    }
+    m_nodesCreatedPerSecond = perSecond;
+    return true;
+}
+
+#include "moc_renderstatistics.cpp"
@@ -0,0 +1,108 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 LingmoOS Team
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QQmlEngine>
+#include <QTimer>
+
+#include <atomic>
+
+/**
+ * @brief Counters for the work done by primitives on the render thread.
+ *
+ * The counters are global and cumulative, they are intended to be read by
+ * benchmarks and profiling tools to check how often the scene graph nodes of
+ * ShadowedRectangle and related types actually push new state to the renderer.
+ *
+ * All counters can be updated from any thread. Their change signals are
+ * emitted from a timer on the GUI thread, once per second at most and only
+ * while something is connected to them, such as a binding.
+ *
+ * @since 6.5
+ */
+class RenderStatistics : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    /**
+     * @brief The number of times a node marked its material dirty.
+     */
+    Q_PROPERTY(qint64 materialUploads READ materialUploads NOTIFY changed FINAL)
+
+    /**
+     * @brief The number of times a node rebuilt its geometry.
+     */
+    Q_PROPERTY(qint64 geometryUploads READ geometryUploads NOTIFY changed FINAL)
+
+    /**
+     * @brief The number of scene graph nodes created.
+     */
+    Q_PROPERTY(qint64 nodesCreated READ nodesCreated NOTIFY changed FINAL)
+
+    /**
+     * @brief The number of scene graph nodes created during the last second.
+     *
+     * This is sampled once per second, only while something is connected to
+     * its change signal, such as a binding; otherwise it keeps the last sampled
+     * value. A consistently high value means nodes are being recreated instead
+     * of reused.
+     */
+    Q_PROPERTY(qint64 nodesCreatedPerSecond READ nodesCreatedPerSecond NOTIFY nodesCreatedPerSecondChanged FINAL)
+
+public:
+    explicit RenderStatistics(QObject *parent = nullptr);
+
+    static qint64 materialUploads();
+    static void addMaterialUpload();
+
+    static qint64 geometryUploads();
+    static void addGeometryUpload();
+
+    static qint64 nodesCreated();
+    static void addNodeCreated();
+
+    qint64 nodesCreatedPerSecond() const;
+    Q_SIGNAL void nodesCreatedPerSecondChanged();
+
+    /**
+     * @brief Reset all counters to zero.
+     */
+    Q_INVOKABLE void reset();
+
+Q_SIGNALS:
+    /**
+     * Emitted when any of the cumulative counters changed since the last emission
+     */
+    void changed();
+
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
+private:
+    void sample();
+    bool updateRate();
+    bool isSampled(const QMetaMethod &signal) const;
+
+    QTimer m_sampleTimer;
+    int m_listeners = 0;
+    // The counters as of the last changed() signal
+    qint64 m_notifiedMaterialUploads = 0;
+    qint64 m_notifiedGeometryUploads = 0;
+    qint64 m_notifiedNodesCreated = 0;
+    QElapsedTimer m_sampleClock;
+    qint64 m_lastNodesCreated = 0;
+    qint64 m_nodesCreatedPerSecond = 0;
+
+    static std::atomic<qint64> s_materialUploads;
+    static std::atomic<qint64> s_geometryUploads;
+    static std::atomic<qint64> s_nodesCreated;
+};
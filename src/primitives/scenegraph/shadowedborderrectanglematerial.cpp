@@ -9,6 +9,7 @@
 #include <QOpenGLContext>
 
 QSGMaterialType ShadowedBorderRectangleMaterial::staticType;
+QSGMaterialType ShadowedBorderRectangleMaterial::lowPowerStaticType;
 
 ShadowedBorderRectangleMaterial::ShadowedBorderRectangleMaterial()
 {
@@ -22,7 +23,7 @@ QSGMaterialShader *ShadowedBorderRectangleMaterial::createShader(QSGRendererInte
 
 QSGMaterialType *ShadowedBorderRectangleMaterial::type() const
 {
-    return &staticType;
+    return shaderType == ShaderType::LowPower ? &lowPowerStaticType : &staticType;
 }
 
 int ShadowedBorderRectangleMaterial::compare(const QSGMaterial *other) const
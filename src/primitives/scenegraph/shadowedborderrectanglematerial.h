@@ -27,6 +27,7 @@ public:
     QColor borderColor = Qt::black;
 
     static QSGMaterialType staticType;
+    static QSGMaterialType lowPowerStaticType;
 };
 
 class ShadowedBorderRectangleShader : public ShadowedRectangleShader
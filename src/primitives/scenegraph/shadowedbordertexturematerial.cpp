@@ -9,6 +9,7 @@
 #include <QOpenGLContext>
 
 QSGMaterialType ShadowedBorderTextureMaterial::staticType;
+QSGMaterialType ShadowedBorderTextureMaterial::lowPowerStaticType;
 
 ShadowedBorderTextureMaterial::ShadowedBorderTextureMaterial()
     : ShadowedBorderRectangleMaterial()
@@ -23,7 +24,7 @@ QSGMaterialShader *ShadowedBorderTextureMaterial::createShader(QSGRendererInterf
 
 QSGMaterialType *ShadowedBorderTextureMaterial::type() const
 {
-    return &staticType;
+    return shaderType == ShaderType::LowPower ? &lowPowerStaticType : &staticType;
 }
 
 int ShadowedBorderTextureMaterial::compare(const QSGMaterial *other) const
@@ -31,11 +32,15 @@ int ShadowedBorderTextureMaterial::compare(const QSGMaterial *other) const
     auto material = static_cast<const ShadowedBorderTextureMaterial *>(other);
 
     auto result = ShadowedBorderRectangleMaterial::compare(other);
-    if (result == 0) {
-        if (material->textureSource == textureSource) {
+    if (result == 0 && material->textureRect == textureRect) {
+        // Compare the underlying textures rather than the QSGTexture objects,
+        // since textures from the same atlas page are separate objects.
+        const auto key = textureSource ? textureSource->comparisonKey() : 0;
+        const auto otherKey = material->textureSource ? material->textureSource->comparisonKey() : 0;
+        if (key == otherKey) {
             return 0;
         } else {
-            return (material->textureSource < textureSource) ? 1 : -1;
+            return (otherKey < key) ? 1 : -1;
         }
     }
 
@@ -48,6 +53,21 @@ ShadowedBorderTextureShader::ShadowedBorderTextureShader(ShadowedRectangleMateri
     setShader(shaderType, QStringLiteral("shadowedbordertexture"));
 }
 
+bool ShadowedBorderTextureShader::updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
+{
+    bool changed = ShadowedBorderRectangleShader::updateUniformData(state, newMaterial, oldMaterial);
+    QByteArray *buf = state.uniformData();
+    Q_ASSERT(buf->size() >= 176);
+
+    if (!oldMaterial || newMaterial->compare(oldMaterial) != 0) {
+        const auto material = static_cast<ShadowedBorderTextureMaterial *>(newMaterial);
+        memcpy(buf->data() + 160, &material->textureRect, 16);
+        changed = true;
+    }
+
+    return changed;
+}
+
 void ShadowedBorderTextureShader::updateSampledImage(QSGMaterialShader::RenderState &state,
                                                      int binding,
                                                      QSGTexture **texture,
@@ -9,6 +9,7 @@
 #include <QOpenGLContext>
 
 QSGMaterialType ShadowedRectangleMaterial::staticType;
+QSGMaterialType ShadowedRectangleMaterial::lowPowerStaticType;
 
 ShadowedRectangleMaterial::ShadowedRectangleMaterial()
 {
@@ -22,7 +23,9 @@ QSGMaterialShader *ShadowedRectangleMaterial::createShader(QSGRendererInterface:
 
 QSGMaterialType *ShadowedRectangleMaterial::type() const
 {
-    return &staticType;
+    // The renderer caches shaders per material type, so the low power variant
+    // needs its own type.
+    return shaderType == ShaderType::LowPower ? &lowPowerStaticType : &staticType;
 }
 
 int ShadowedRectangleMaterial::compare(const QSGMaterial *other) const
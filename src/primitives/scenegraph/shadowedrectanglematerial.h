@@ -39,6 +39,7 @@ public:
     ShaderType shaderType = ShaderType::Standard;
 
     static QSGMaterialType staticType;
+    static QSGMaterialType lowPowerStaticType;
 };
 
 class ShadowedRectangleShader : public QSGMaterialShader
@@ -7,6 +7,8 @@
 #include "shadowedrectanglenode.h"
 #include "shadowedborderrectanglematerial.h"
 
+#include "renderstatistics.h"
+
 QColor premultiply(const QColor &color)
 {
     return QColor::fromRgbF(color.redF() * color.alphaF(), //
@@ -17,38 +19,35 @@ QColor premultiply(const QColor &color)
 
 ShadowedRectangleNode::ShadowedRectangleNode()
 {
+    RenderStatistics::addNodeCreated();
+
     m_geometry = new QSGGeometry{QSGGeometry::defaultAttributes_TexturedPoint2D(), 4};
     setGeometry(m_geometry);
 
     setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
 }
 
-void ShadowedRectangleNode::setBorderEnabled(bool enabled)
+bool ShadowedRectangleNode::setBorderEnabled(bool enabled)
 {
     // We can achieve more performant shaders by splitting the two into separate
     // shaders. This requires separating the materials as well. So when
     // borderWidth is increased to something where the border should be visible,
     // switch to the with-border material. Otherwise use the no-border version.
 
-    if (enabled) {
-        if (!m_material || m_material->type() == borderlessMaterialType()) {
-            auto newMaterial = createBorderMaterial();
-            newMaterial->shaderType = m_shaderType;
-            setMaterial(newMaterial);
-            m_material = newMaterial;
-            m_rect = QRectF{};
-            markDirty(QSGNode::DirtyMaterial);
-        }
-    } else {
-        if (!m_material || m_material->type() == borderMaterialType()) {
-            auto newMaterial = createBorderlessMaterial();
-            newMaterial->shaderType = m_shaderType;
-            setMaterial(newMaterial);
-            m_material = newMaterial;
-            m_rect = QRectF{};
-            markDirty(QSGNode::DirtyMaterial);
-        }
+    m_borderEnabled = enabled;
+
+    auto materialType = enabled ? borderMaterialType() : borderlessMaterialType();
+    if (m_material && m_material->type() == materialType) {
+        return false;
     }
+
+    ShadowedRectangleMaterial *newMaterial = enabled ? createBorderMaterial() : createBorderlessMaterial();
+    newMaterial->shaderType = m_shaderType;
+    setMaterial(newMaterial);
+    m_material = newMaterial;
+    m_rect = QRectF{};
+    m_pendingDirty |= QSGNode::DirtyMaterial;
+    return true;
 }
 
 void ShadowedRectangleNode::setRect(const QRectF &rect)
@@ -58,6 +57,7 @@ void ShadowedRectangleNode::setRect(const QRectF &rect)
     }
 
     m_rect = rect;
+    m_geometryDirty = true;
 
     QVector2D newAspect{1.0, 1.0};
     if (m_rect.width() >= m_rect.height()) {
@@ -68,7 +68,7 @@ void ShadowedRectangleNode::setRect(const QRectF &rect)
 
     if (m_material->aspect != newAspect) {
         m_material->aspect = newAspect;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
         m_aspect = newAspect;
     }
 }
@@ -80,8 +80,9 @@ void ShadowedRectangleNode::setSize(qreal size)
 
     if (!qFuzzyCompare(m_material->size, uniformSize)) {
         m_material->size = uniformSize;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
         m_size = size;
+        m_geometryDirty = true;
     }
 }
 
@@ -95,7 +96,7 @@ void ShadowedRectangleNode::setRadius(const QVector4D &radius)
 
     if (m_material->radius != uniformRadius) {
         m_material->radius = uniformRadius;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
         m_radius = radius;
     }
 }
@@ -105,7 +106,7 @@ void ShadowedRectangleNode::setColor(const QColor &color)
     auto premultiplied = premultiply(color);
     if (m_material->color != premultiplied) {
         m_material->color = premultiplied;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
     }
 }
 
@@ -114,7 +115,7 @@ void ShadowedRectangleNode::setShadowColor(const QColor &color)
     auto premultiplied = premultiply(color);
     if (m_material->shadowColor != premultiplied) {
         m_material->shadowColor = premultiplied;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
     }
 }
 
@@ -125,8 +126,9 @@ void ShadowedRectangleNode::setOffset(const QVector2D &offset)
 
     if (m_material->offset != uniformOffset) {
         m_material->offset = uniformOffset;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
         m_offset = offset;
+        m_geometryDirty = true;
     }
 }
 
@@ -142,7 +144,7 @@ void ShadowedRectangleNode::setBorderWidth(qreal width)
     auto borderMaterial = static_cast<ShadowedBorderRectangleMaterial *>(m_material);
     if (!qFuzzyCompare(borderMaterial->borderWidth, uniformBorderWidth)) {
         borderMaterial->borderWidth = uniformBorderWidth;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
         m_borderWidth = width;
     }
 }
@@ -157,16 +159,48 @@ void ShadowedRectangleNode::setBorderColor(const QColor &color)
     auto premultiplied = premultiply(color);
     if (borderMaterial->borderColor != premultiplied) {
         borderMaterial->borderColor = premultiplied;
-        markDirty(QSGNode::DirtyMaterial);
+        m_pendingDirty |= QSGNode::DirtyMaterial;
     }
 }
 
-void ShadowedRectangleNode::setShaderType(ShadowedRectangleMaterial::ShaderType type)
+bool ShadowedRectangleNode::setShaderType(ShadowedRectangleMaterial::ShaderType type)
 {
+    if (type == m_shaderType) {
+        return false;
+    }
+
     m_shaderType = type;
+    m_geometryDirty = true;
+
+    // The shader type is part of the material, so switching it at runtime
+    // means replacing the material.
+    if (m_material) {
+        return setBorderEnabled(m_borderEnabled);
+    }
+
+    return false;
 }
 
 void ShadowedRectangleNode::updateGeometry()
+{
+    if (m_geometryDirty) {
+        rebuildGeometry();
+        m_geometryDirty = false;
+        m_pendingDirty |= QSGNode::DirtyGeometry;
+        RenderStatistics::addGeometryUpload();
+    }
+
+    if (m_pendingDirty & QSGNode::DirtyMaterial) {
+        RenderStatistics::addMaterialUpload();
+    }
+
+    if (m_pendingDirty) {
+        markDirty(m_pendingDirty);
+        m_pendingDirty = {};
+    }
+}
+
+void ShadowedRectangleNode::rebuildGeometry()
 {
     auto rect = m_rect;
     if (m_shaderType == ShadowedRectangleMaterial::ShaderType::Standard) {
@@ -183,7 +217,6 @@ void ShadowedRectangleNode::updateGeometry()
     }
 
     QSGGeometry::updateTexturedRectGeometry(m_geometry, rect, QRectF{0.0, 0.0, 1.0, 1.0});
-    markDirty(QSGNode::DirtyGeometry);
 }
 
 ShadowedRectangleMaterial *ShadowedRectangleNode::createBorderlessMaterial()
@@ -198,10 +231,16 @@ ShadowedBorderRectangleMaterial *ShadowedRectangleNode::createBorderMaterial()
 
 QSGMaterialType *ShadowedRectangleNode::borderlessMaterialType()
 {
+    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::LowPower) {
+        return &ShadowedRectangleMaterial::lowPowerStaticType;
+    }
     return &ShadowedRectangleMaterial::staticType;
 }
 
 QSGMaterialType *ShadowedRectangleNode::borderMaterialType()
 {
+    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::LowPower) {
+        return &ShadowedBorderRectangleMaterial::lowPowerStaticType;
+    }
     return &ShadowedBorderRectangleMaterial::staticType;
 }
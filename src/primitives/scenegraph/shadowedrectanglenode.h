@@ -37,8 +37,11 @@ public:
      *
      * Note that this will switch between a material with or without border.
      * This means this needs to be called before any other setters.
+     *
+     * \return true if the material was replaced, in which case all other
+     * properties need to be set again.
      */
-    void setBorderEnabled(bool enabled);
+    bool setBorderEnabled(bool enabled);
 
     void setRect(const QRectF &rect);
     void setSize(qreal size);
@@ -48,13 +51,21 @@ public:
     void setOffset(const QVector2D &offset);
     void setBorderWidth(qreal width);
     void setBorderColor(const QColor &color);
-    void setShaderType(ShadowedRectangleMaterial::ShaderType type);
+    /**
+     * Set the type of shader to use.
+     *
+     * \return true if the material was replaced, in which case all other
+     * properties need to be set again.
+     */
+    bool setShaderType(ShadowedRectangleMaterial::ShaderType type);
 
     /**
      * Update the geometry for this node.
      *
      * This is done as an explicit step to avoid the geometry being recreated
-     * multiple times while updating properties.
+     * multiple times while updating properties. The geometry is only rebuilt
+     * when one of the properties affecting it actually changed, and all dirty
+     * state accumulated by the setters is flushed to the renderer at once.
      */
     void updateGeometry();
 
@@ -66,9 +77,12 @@ protected:
 
     QSGGeometry *m_geometry;
     ShadowedRectangleMaterial *m_material = nullptr;
+    bool m_borderEnabled = false;
     ShadowedRectangleMaterial::ShaderType m_shaderType = ShadowedRectangleMaterial::ShaderType::Standard;
 
 private:
+    void rebuildGeometry();
+
     QRectF m_rect;
     qreal m_size = 0.0;
     QVector4D m_radius = QVector4D{0.0, 0.0, 0.0, 0.0};
@@ -76,4 +90,6 @@ private:
     QVector2D m_aspect = QVector2D{1.0, 1.0};
     qreal m_borderWidth = 0.0;
     QColor m_borderColor;
+    bool m_geometryDirty = true;
+    QSGNode::DirtyState m_pendingDirty;
 };
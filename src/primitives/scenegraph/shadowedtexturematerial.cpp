@@ -9,6 +9,7 @@
 #include <QOpenGLContext>
 
 QSGMaterialType ShadowedTextureMaterial::staticType;
+QSGMaterialType ShadowedTextureMaterial::lowPowerStaticType;
 
 ShadowedTextureMaterial::ShadowedTextureMaterial()
     : ShadowedRectangleMaterial()
@@ -23,7 +24,7 @@ QSGMaterialShader *ShadowedTextureMaterial::createShader(QSGRendererInterface::R
 
 QSGMaterialType *ShadowedTextureMaterial::type() const
 {
-    return &staticType;
+    return shaderType == ShaderType::LowPower ? &lowPowerStaticType : &staticType;
 }
 
 int ShadowedTextureMaterial::compare(const QSGMaterial *other) const
@@ -31,11 +32,15 @@ int ShadowedTextureMaterial::compare(const QSGMaterial *other) const
     auto material = static_cast<const ShadowedTextureMaterial *>(other);
 
     auto result = ShadowedRectangleMaterial::compare(other);
-    if (result == 0) {
-        if (material->textureSource == textureSource) {
+    if (result == 0 && material->textureRect == textureRect) {
+        // Compare the underlying textures rather than the QSGTexture objects,
+        // since textures from the same atlas page are separate objects.
+        const auto key = textureSource ? textureSource->comparisonKey() : 0;
+        const auto otherKey = material->textureSource ? material->textureSource->comparisonKey() : 0;
+        if (key == otherKey) {
             return 0;
         } else {
-            return (material->textureSource < textureSource) ? 1 : -1;
+            return (otherKey < key) ? 1 : -1;
         }
     }
 
@@ -48,6 +53,21 @@ ShadowedTextureShader::ShadowedTextureShader(ShadowedRectangleMaterial::ShaderTy
     setShader(shaderType, QStringLiteral("shadowedtexture"));
 }
 
+bool ShadowedTextureShader::updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
+{
+    bool changed = ShadowedRectangleShader::updateUniformData(state, newMaterial, oldMaterial);
+    QByteArray *buf = state.uniformData();
+    Q_ASSERT(buf->size() >= 176);
+
+    if (!oldMaterial || newMaterial->compare(oldMaterial) != 0) {
+        const auto material = static_cast<ShadowedTextureMaterial *>(newMaterial);
+        memcpy(buf->data() + 160, &material->textureRect, 16);
+        changed = true;
+    }
+
+    return changed;
+}
+
 void ShadowedTextureShader::updateSampledImage(QSGMaterialShader::RenderState &state,
                                                int binding,
                                                QSGTexture **texture,
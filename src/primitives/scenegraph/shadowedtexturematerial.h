@@ -7,6 +7,7 @@
 #pragma once
 
 #include <QSGTexture>
+#include <QVector4D>
 
 #include "shadowedrectanglematerial.h"
 
@@ -26,8 +27,11 @@ public:
     int compare(const QSGMaterial *other) const override;
 
     QSGTexture *textureSource = nullptr;
+    // Normalized sub-rectangle of textureSource to sample, as x, y, width, height.
+    QVector4D textureRect = QVector4D{0.0, 0.0, 1.0, 1.0};
 
     static QSGMaterialType staticType;
+    static QSGMaterialType lowPowerStaticType;
 };
 
 class ShadowedTextureShader : public ShadowedRectangleShader
@@ -35,6 +39,7 @@ class ShadowedTextureShader : public ShadowedRectangleShader
 public:
     ShadowedTextureShader(ShadowedRectangleMaterial::ShaderType shaderType);
 
+    bool updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
     void
     updateSampledImage(QSGMaterialShader::RenderState &state, int binding, QSGTexture **texture, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
 };
@@ -9,21 +9,26 @@
 #include "shadowedbordertexturematerial.h"
 
 template<typename T>
-inline void preprocessTexture(QSGMaterial *material, QSGTextureProvider *provider)
+inline bool preprocessTexture(QSGMaterial *material, QSGTextureProvider *provider)
 {
     auto m = static_cast<T *>(material);
-    // Since we handle texture coordinates differently in the shader, we
-    // need to remove the texture from the atlas for now.
-    if (provider->texture()->isAtlasTexture()) {
-        // Blegh, I have no idea why "removedFromAtlas" doesn't just return
-        // the texture when it's not an atlas.
-        m->textureSource = provider->texture()->removedFromAtlas();
-    } else {
-        m->textureSource = provider->texture();
-    }
-    if (QSGDynamicTexture *dynamic_texture = qobject_cast<QSGDynamicTexture *>(m->textureSource)) {
+    auto texture = provider->texture();
+    if (QSGDynamicTexture *dynamic_texture = qobject_cast<QSGDynamicTexture *>(texture)) {
         dynamic_texture->updateTexture();
     }
+
+    // Atlas textures are sampled in place, the shader maps its texture
+    // coordinates into the sub-rectangle the texture occupies in the atlas.
+    const auto subRect = texture->normalizedTextureSubRect();
+    const auto textureRect = QVector4D{float(subRect.x()), float(subRect.y()), float(subRect.width()), float(subRect.height())};
+
+    if (m->textureSource == texture && m->textureRect == textureRect) {
+        return false;
+    }
+
+    m->textureSource = texture;
+    m->textureRect = textureRect;
+    return true;
 }
 
 ShadowedTextureNode::ShadowedTextureNode()
@@ -37,50 +42,85 @@ ShadowedTextureNode::~ShadowedTextureNode()
     QObject::disconnect(m_textureChangeConnectionHandle);
 }
 
-void ShadowedTextureNode::setTextureSource(QSGTextureProvider *source)
+bool ShadowedTextureNode::setTextureSource(QSGTextureProvider *source)
 {
     if (m_textureSource == source) {
-        return;
+        return false;
     }
 
-    if (m_textureSource) {
-        m_textureSource->disconnect();
-    }
+    QObject::disconnect(m_textureChangeConnectionHandle);
 
+    const bool hadTexture = !m_textureSource.isNull();
     m_textureSource = source;
-    m_textureChangeConnectionHandle = QObject::connect(m_textureSource.data(), &QSGTextureProvider::textureChanged, [this] {
-        markDirty(QSGNode::DirtyMaterial);
-    });
+    if (m_textureSource) {
+        m_textureChangeConnectionHandle = QObject::connect(m_textureSource.data(), &QSGTextureProvider::textureChanged, [this] {
+            markDirty(QSGNode::DirtyMaterial);
+        });
+    }
     markDirty(QSGNode::DirtyMaterial);
+
+    // Swapping between two texture providers only requires updating the
+    // texture in preprocess(), but going from or to no texture at all means
+    // a different material.
+    if (m_material && hadTexture != !m_textureSource.isNull()) {
+        return setBorderEnabled(m_borderEnabled);
+    }
+
+    return false;
 }
 
 void ShadowedTextureNode::preprocess()
 {
-    if (m_textureSource && m_material && m_textureSource->texture()) {
-        if (m_material->type() == borderlessMaterialType()) {
-            preprocessTexture<ShadowedTextureMaterial>(m_material, m_textureSource);
-        } else {
-            preprocessTexture<ShadowedBorderTextureMaterial>(m_material, m_textureSource);
-        }
+    if (!m_textureSource || !m_material || !m_textureSource->texture()) {
+        return;
+    }
+
+    bool changed = false;
+    if (m_material->type() == borderlessMaterialType()) {
+        changed = preprocessTexture<ShadowedTextureMaterial>(m_material, m_textureSource);
+    } else if (m_material->type() == borderMaterialType()) {
+        changed = preprocessTexture<ShadowedBorderTextureMaterial>(m_material, m_textureSource);
+    }
+
+    if (changed) {
+        markDirty(QSGNode::DirtyMaterial);
     }
 }
 
 ShadowedRectangleMaterial *ShadowedTextureNode::createBorderlessMaterial()
 {
+    if (!m_textureSource) {
+        return ShadowedRectangleNode::createBorderlessMaterial();
+    }
     return new ShadowedTextureMaterial{};
 }
 
 ShadowedBorderRectangleMaterial *ShadowedTextureNode::createBorderMaterial()
 {
+    if (!m_textureSource) {
+        return ShadowedRectangleNode::createBorderMaterial();
+    }
     return new ShadowedBorderTextureMaterial{};
 }
 
 QSGMaterialType *ShadowedTextureNode::borderlessMaterialType()
 {
+    if (!m_textureSource) {
+        return ShadowedRectangleNode::borderlessMaterialType();
+    }
+    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::LowPower) {
+        return &ShadowedTextureMaterial::lowPowerStaticType;
+    }
     return &ShadowedTextureMaterial::staticType;
 }
 
 QSGMaterialType *ShadowedTextureNode::borderMaterialType()
 {
+    if (!m_textureSource) {
+        return ShadowedRectangleNode::borderMaterialType();
+    }
+    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::LowPower) {
+        return &ShadowedBorderTextureMaterial::lowPowerStaticType;
+    }
     return &ShadowedBorderTextureMaterial::staticType;
 }
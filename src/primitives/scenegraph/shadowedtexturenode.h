@@ -30,7 +30,16 @@ public:
     ShadowedTextureNode();
     ~ShadowedTextureNode();
 
-    void setTextureSource(QSGTextureProvider *source);
+    /**
+     * Set the texture provider to render.
+     *
+     * When there is no texture provider, this node renders a plain shadowed
+     * rectangle instead.
+     *
+     * \return true if the material was replaced, in which case all other
+     * properties need to be set again.
+     */
+    bool setTextureSource(QSGTextureProvider *source);
     void preprocess() override;
 
 private:
@@ -39,7 +39,9 @@ void main()
 
     // Sample the texture, then render it, blending with the background color.
     lowp vec2 texture_uv = ((uv / ubuf.aspect) + 1.0) / 2.0;
-    lowp vec4 texture_color = texture(textureSource, texture_uv);
+    // The texture may be a sub-rectangle of an atlas, so map into that.
+    highp vec2 atlas_uv = ubuf.textureRect.xy + clamp(texture_uv, 0.0, 1.0) * ubuf.textureRect.zw;
+    lowp vec4 texture_color = texture(textureSource, atlas_uv);
     col = sdf_render(inner_rect, col, texture_color, texture_color.a, sdf_default_smoothing);
 
     out_color = col * ubuf.opacity;
@@ -17,4 +17,6 @@ layout(std140, binding = 0) uniform buf {
 
     lowp float borderWidth; // offset 136
     lowp vec4 borderColor; // offset 144
-} ubuf; // size 160
+
+    highp vec4 textureRect; // offset 160
+} ubuf; // size 176
@@ -10,6 +10,7 @@
 #include <QSGRectangleNode>
 #include <QSGRendererInterface>
 
+#include "frametimemonitor.h"
 #include "scenegraph/paintedrectangleitem.h"
 #include "scenegraph/shadowedrectanglenode.h"
 
@@ -194,9 +195,15 @@ ShadowedRectangle::ShadowedRectangle(QQuickItem *parentItem)
 {
     setFlag(QQuickItem::ItemHasContents, true);
 
-    connect(m_border.get(), &BorderGroup::changed, this, &ShadowedRectangle::update);
-    connect(m_shadow.get(), &ShadowGroup::changed, this, &ShadowedRectangle::update);
-    connect(m_corners.get(), &CornersGroup::changed, this, &ShadowedRectangle::update);
+    connect(m_border.get(), &BorderGroup::changed, this, [this]() {
+        markPropertiesDirty(BorderDirty);
+    });
+    connect(m_shadow.get(), &ShadowGroup::changed, this, [this]() {
+        markPropertiesDirty(ShadowDirty);
+    });
+    connect(m_corners.get(), &CornersGroup::changed, this, [this]() {
+        markPropertiesDirty(RadiusDirty);
+    });
 }
 
 ShadowedRectangle::~ShadowedRectangle()
@@ -231,7 +238,7 @@ void ShadowedRectangle::setRadius(qreal newRadius)
 
     m_radius = newRadius;
     if (!isSoftwareRendering()) {
-        update();
+        markPropertiesDirty(RadiusDirty);
     }
     Q_EMIT radiusChanged();
 }
@@ -249,7 +256,7 @@ void ShadowedRectangle::setColor(const QColor &newColor)
 
     m_color = newColor;
     if (!isSoftwareRendering()) {
-        update();
+        markPropertiesDirty(ColorDirty);
     }
     Q_EMIT colorChanged();
 }
@@ -265,6 +272,7 @@ void ShadowedRectangle::setRenderType(RenderType renderType)
         return;
     }
     m_renderType = renderType;
+    updateFrameTimeMonitor(window());
     update();
     Q_EMIT renderTypeChanged();
 }
@@ -281,6 +289,11 @@ bool ShadowedRectangle::isSoftwareRendering() const
     return (window() && window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software) || m_renderType == RenderType::Software;
 }
 
+bool ShadowedRectangle::isQualityReduced() const
+{
+    return m_renderType == RenderType::Adaptive && m_frameTimeMonitor && m_frameTimeMonitor->isQualityReduced();
+}
+
 PaintedRectangleItem *ShadowedRectangle::softwareItem() const
 {
     return m_softwareItem;
@@ -288,6 +301,10 @@ PaintedRectangleItem *ShadowedRectangle::softwareItem() const
 
 void ShadowedRectangle::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
 {
+    if (change == QQuickItem::ItemSceneChange) {
+        updateFrameTimeMonitor(value.window);
+    }
+
     if (change == QQuickItem::ItemSceneChange && value.window) {
         checkSoftwareItem();
         // TODO: only conditionally emit?
@@ -297,6 +314,17 @@ void ShadowedRectangle::itemChange(QQuickItem::ItemChange change, const QQuickIt
     QQuickItem::itemChange(change, value);
 }
 
+void ShadowedRectangle::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    if (newGeometry.size() != oldGeometry.size()) {
+        // A size change already schedules a paint node update, we only need to
+        // remember that the geometry-relative values need recalculating.
+        m_dirty |= GeometryDirty;
+    }
+
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+}
+
 QSGNode *ShadowedRectangle::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data)
 {
     Q_UNUSED(data);
@@ -307,28 +335,114 @@ QSGNode *ShadowedRectangle::updatePaintNode(QSGNode *node, QQuickItem::UpdatePai
     }
 
     auto shadowNode = static_cast<ShadowedRectangleNode *>(node);
+    const bool newNode = !shadowNode;
 
-    if (!shadowNode) {
+    if (newNode) {
         shadowNode = new ShadowedRectangleNode{};
+    }
 
-        // Cache lowPower state so we only execute the full check once.
-        static bool lowPower = QByteArrayList{"1", "true"}.contains(qgetenv("LINGMOUI_LOWPOWER_HARDWARE").toLower());
-        if (m_renderType == RenderType::LowQuality || (m_renderType == RenderType::Auto && lowPower)) {
-            shadowNode->setShaderType(ShadowedRectangleMaterial::ShaderType::LowPower);
+    updateShadowedRectangleNode(shadowNode, newNode);
+    return shadowNode;
+}
+
+void ShadowedRectangle::updateShadowedRectangleNode(ShadowedRectangleNode *node, bool fullUpdate)
+{
+    if (fullUpdate) {
+        m_dirty = AllDirty;
+    }
+
+    const auto shaderType = useLowPowerShaders() ? ShadowedRectangleMaterial::ShaderType::LowPower : ShadowedRectangleMaterial::ShaderType::Standard;
+    if (node->setShaderType(shaderType)) {
+        m_dirty = AllDirty;
+    }
+
+    if (m_dirty & BorderDirty) {
+        // Switching between bordered and borderless replaces the material,
+        // which means every uniform needs to be set again.
+        if (node->setBorderEnabled(m_border->isEnabled())) {
+            m_dirty = AllDirty;
         }
     }
 
-    shadowNode->setBorderEnabled(m_border->isEnabled());
-    shadowNode->setRect(boundingRect());
-    shadowNode->setSize(m_shadow->size());
-    shadowNode->setRadius(m_corners->toVector4D(m_radius));
-    shadowNode->setOffset(QVector2D{float(m_shadow->xOffset()), float(m_shadow->yOffset())});
-    shadowNode->setColor(m_color);
-    shadowNode->setShadowColor(m_shadow->color());
-    shadowNode->setBorderWidth(m_border->width());
-    shadowNode->setBorderColor(m_border->color());
-    shadowNode->updateGeometry();
-    return shadowNode;
+    // All size-related uniforms are normalized to the rectangle's size, so
+    // they need to be recalculated whenever the geometry changes.
+    if (m_dirty & GeometryDirty) {
+        node->setRect(boundingRect());
+    }
+    if (m_dirty & (GeometryDirty | ShadowDirty)) {
+        node->setSize(m_shadow->size());
+        node->setOffset(QVector2D{float(m_shadow->xOffset()), float(m_shadow->yOffset())});
+    }
+    if (m_dirty & (GeometryDirty | RadiusDirty)) {
+        node->setRadius(m_corners->toVector4D(m_radius));
+    }
+    if (m_dirty & ColorDirty) {
+        node->setColor(m_color);
+    }
+    if (m_dirty & ShadowDirty) {
+        node->setShadowColor(m_shadow->color());
+    }
+    if (m_dirty & (GeometryDirty | BorderDirty)) {
+        node->setBorderWidth(m_border->width());
+    }
+    if (m_dirty & BorderDirty) {
+        node->setBorderColor(m_border->color());
+    }
+
+    m_dirty = 0;
+    node->updateGeometry();
+}
+
+void ShadowedRectangle::markPropertiesDirty(uint flags)
+{
+    m_dirty |= flags;
+    update();
+}
+
+bool ShadowedRectangle::useLowPowerShaders() const
+{
+    // Cache lowPower state so we only execute the full check once.
+    static bool lowPower = QByteArrayList{"1", "true"}.contains(qgetenv("LINGMOUI_LOWPOWER_HARDWARE").toLower());
+
+    switch (m_renderType) {
+    case RenderType::LowQuality:
+        return true;
+    case RenderType::Auto:
+        return lowPower;
+    case RenderType::Adaptive:
+        return lowPower || isQualityReduced();
+    case RenderType::HighQuality:
+    case RenderType::Software:
+        break;
+    }
+
+    return false;
+}
+
+void ShadowedRectangle::updateFrameTimeMonitor(QQuickWindow *window)
+{
+    const bool wasQualityReduced = isQualityReduced();
+
+    auto monitor = m_renderType == RenderType::Adaptive ? FrameTimeMonitor::forWindow(window) : nullptr;
+    if (monitor != m_frameTimeMonitor) {
+        if (m_frameTimeMonitor) {
+            disconnect(m_frameTimeMonitor, nullptr, this, nullptr);
+        }
+
+        m_frameTimeMonitor = monitor;
+
+        if (m_frameTimeMonitor) {
+            connect(m_frameTimeMonitor, &FrameTimeMonitor::qualityReducedChanged, this, [this]() {
+                update();
+                Q_EMIT qualityReducedChanged();
+            });
+        }
+    }
+
+    if (isQualityReduced() != wasQualityReduced) {
+        update();
+        Q_EMIT qualityReducedChanged();
+    }
 }
 
 void ShadowedRectangle::checkSoftwareItem()
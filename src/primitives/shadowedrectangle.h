@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <QPointer>
 #include <QQuickItem>
 #include <memory>
 
 #include <QQmlEngine>
 
+class FrameTimeMonitor;
 class PaintedRectangleItem;
+class ShadowedRectangleNode;
 
 /**
  * @brief Grouped property for rectangle border.
@@ -288,6 +291,18 @@ class ShadowedRectangle : public QQuickItem
      */
     Q_PROPERTY(bool softwareRendering READ isSoftwareRendering NOTIFY softwareRenderingChanged FINAL)
 
+    /**
+     * @brief This property tells whether the rectangle is currently rendered
+     * at reduced quality because its window misses its frame budget.
+     *
+     * This can only be true when renderType is ``RenderType::Adaptive``.
+     *
+     * default: ``false``
+     *
+     * @see RenderType
+     */
+    Q_PROPERTY(bool qualityReduced READ isQualityReduced NOTIFY qualityReducedChanged FINAL)
+
 public:
     ShadowedRectangle(QQuickItem *parent = nullptr);
     ~ShadowedRectangle() override;
@@ -327,7 +342,18 @@ public:
          * graph is configured to use software rendering. It will result in
          * a number of missing features, like shadows and multiple corner radii.
          */
-        Software
+        Software,
+
+        /**
+         * @brief Adapt the rendering quality to the measured frame time.
+         *
+         * This behaves like Auto, but switches to low quality rendering while
+         * the window repeatedly exceeds its frame budget, and back to high
+         * quality once the load drops again.
+         *
+         * @see qualityReduced
+         */
+        Adaptive,
     };
     Q_ENUM(RenderType)
 
@@ -351,16 +377,49 @@ public:
 
     bool isSoftwareRendering() const;
 
+    bool isQualityReduced() const;
+
 Q_SIGNALS:
     void softwareRenderingChanged();
+    void qualityReducedChanged();
 
 protected:
+    /**
+     * Groups of properties that need to be pushed to the scene graph node.
+     *
+     * Only the groups that changed since the last call to updatePaintNode()
+     * are sent to the node, everything else is left as-is.
+     */
+    enum DirtyFlag : uint {
+        GeometryDirty = 1 << 0,
+        ColorDirty = 1 << 1,
+        RadiusDirty = 1 << 2,
+        ShadowDirty = 1 << 3,
+        BorderDirty = 1 << 4,
+        AllDirty = GeometryDirty | ColorDirty | RadiusDirty | ShadowDirty | BorderDirty,
+    };
+
     PaintedRectangleItem *softwareItem() const;
     void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     QSGNode *updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data) override;
 
+    /**
+     * Push all dirty property groups to \p node and clear the dirty flags.
+     *
+     * When \p fullUpdate is true, all properties are pushed regardless of the
+     * dirty flags, for example because the node or its material is new.
+     *
+     * This also updates the node's geometry, so no further call to
+     * ShadowedRectangleNode::updateGeometry() is needed afterwards.
+     */
+    void updateShadowedRectangleNode(ShadowedRectangleNode *node, bool fullUpdate = false);
+    void markPropertiesDirty(uint flags);
+
 private:
     void checkSoftwareItem();
+    void updateFrameTimeMonitor(QQuickWindow *window);
+    bool useLowPowerShaders() const;
     const std::unique_ptr<BorderGroup> m_border;
     const std::unique_ptr<ShadowGroup> m_shadow;
     const std::unique_ptr<CornersGroup> m_corners;
@@ -368,4 +427,6 @@ private:
     QColor m_color = Qt::white;
     RenderType m_renderType = RenderType::Auto;
     PaintedRectangleItem *m_softwareItem = nullptr;
+    QPointer<FrameTimeMonitor> m_frameTimeMonitor;
+    uint m_dirty = AllDirty;
 };
@@ -33,7 +33,6 @@ void ShadowedTexture::setSource(QQuickItem *newSource)
     }
 
     m_source = newSource;
-    m_sourceChanged = true;
     if (m_source && !m_source->parentItem()) {
         m_source->setParentItem(this);
     }
@@ -53,37 +52,21 @@ QSGNode *ShadowedTexture::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaint
         return nullptr;
     }
 
-    auto shadowNode = static_cast<ShadowedRectangleNode *>(node);
+    // The same node is used whether or not there is a source, so changing the
+    // source only swaps the texture provider instead of creating a new node.
+    auto shadowNode = static_cast<ShadowedTextureNode *>(node);
+    bool fullUpdate = false;
 
-    if (!shadowNode || m_sourceChanged) {
-        m_sourceChanged = false;
-        delete shadowNode;
-        if (m_source) {
-            shadowNode = new ShadowedTextureNode{};
-        } else {
-            shadowNode = new ShadowedRectangleNode{};
-        }
-
-        if (qEnvironmentVariableIsSet("LINGMOUI_LOWPOWER_HARDWARE")) {
-            shadowNode->setShaderType(ShadowedRectangleMaterial::ShaderType::LowPower);
-        }
+    if (!shadowNode) {
+        shadowNode = new ShadowedTextureNode{};
+        fullUpdate = true;
     }
 
-    shadowNode->setBorderEnabled(border()->isEnabled());
-    shadowNode->setRect(boundingRect());
-    shadowNode->setSize(shadow()->size());
-    shadowNode->setRadius(corners()->toVector4D(radius()));
-    shadowNode->setOffset(QVector2D{float(shadow()->xOffset()), float(shadow()->yOffset())});
-    shadowNode->setColor(color());
-    shadowNode->setShadowColor(shadow()->color());
-    shadowNode->setBorderWidth(border()->width());
-    shadowNode->setBorderColor(border()->color());
-
-    if (m_source) {
-        static_cast<ShadowedTextureNode *>(shadowNode)->setTextureSource(m_source->textureProvider());
+    if (shadowNode->setTextureSource(m_source ? m_source->textureProvider() : nullptr)) {
+        fullUpdate = true;
     }
 
-    shadowNode->updateGeometry();
+    updateShadowedRectangleNode(shadowNode, fullUpdate);
     return shadowNode;
 }
 
@@ -42,5 +42,4 @@ protected:
 
 private:
     QQuickItem *m_source = nullptr;
-    bool m_sourceChanged = false;
 };